@@ -31,6 +31,7 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <algorithm>
 
 namespace TBin  = ThorsAnvil::BinaryRep;
 namespace ThorsAnvil
@@ -64,6 +65,7 @@ class BinaryParserUtilBase
         virtual ParserToken getNextToken(ParserInterface& parser, ParserState& state);
 
                 std::string getKey()                            {return getKeyFor(position);}
+                std::size_t getSize() const                     {return end;}
         virtual std::size_t readSize(ParserInterface&)          = 0;
         virtual std::string getKeyFor(std::size_t position)     = 0;
         virtual ParserToken pushNextState(std::size_t position, ParserInterface& parser, ParserState& state, ParserToken norm)    = 0;
@@ -147,7 +149,7 @@ class BinaryParserUtil<T, TraitType::Value>: public BinaryParserUtilBase
 };
 
 template<typename T>
-class BinaryParser: public ParserInterface
+class BinaryParser final: public ParserInterface
 {
     using Traits   = ThorsAnvil::Serialize::Traits<T>;
 
@@ -186,6 +188,10 @@ class BinaryParser: public ParserInterface
 
             state.emplace_back(new BinaryParserUtil<T>());
         }
+        // The binary format is always parsed strictly (the parse type is ignored).
+        BinaryParser(std::istream& stream, ParseType /*Ignored*/)
+            : BinaryParser(stream)
+        {}
         virtual ParserToken     getNextToken()                 override
         {
             if (!state.empty())
@@ -195,6 +201,11 @@ class BinaryParser: public ParserInterface
             return ParserToken::Error;
         }
         virtual std::string     getKey()                       override {return state.back()->getKey();}
+        // The size of an array is written before its values.
+        // It comes from the input so it is capped: a corrupt count must not reserve
+        // more memory than the stream could possibly fill.
+        static constexpr std::size_t sizeHintLimit = 16 * 1024;
+        virtual std::size_t     getSizeHint()                  override {return state.empty() ? 0 : std::min(state.back()->getSize(), sizeHintLimit);}
 
         virtual void    getValue(short int& value)             override {value = TBin::net2Host(read<TBin::BinForm16>());}
         virtual void    getValue(int& value)                   override {value = TBin::net2Host(read<TBin::BinForm32>());}
@@ -213,6 +224,25 @@ class BinaryParser: public ParserInterface
         virtual void    getValue(bool& value)                  override {value = read<unsigned char>();}
 
         virtual void    getValue(std::string& value)           override {value = readString();};
+
+        using ParserInterface::tryGetValue;
+        virtual bool    tryGetValue(short int& value)              override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(int& value)                    override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long int& value)               override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long long int& value)          override {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(unsigned short int& value)     override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned int& value)           override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned long int& value)      override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned long long int& value) override {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(float& value)                  override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(double& value)                 override {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long double& value)            override {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(bool& value)                   override {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(std::string& value)            override {return tryGetValueWith(*this, value);}
 };
 
     }
@@ -12,6 +12,9 @@
 #include "Serialize.h"
 #include "BinaryTHash.h"
 #include "ThorBinaryRep/BinaryRep.h"
+#include <ostream>
+#include <stdexcept>
+#include <vector>
 
 namespace TBin  = ThorsAnvil::BinaryRep;
 namespace ThorsAnvil
@@ -20,7 +23,7 @@ namespace ThorsAnvil
     {
 
 template<typename T>
-class BinaryPrinter: public PrinterInterface
+class BinaryPrinter final: public PrinterInterface
 {
     template<typename Out>
     void write(Out value)
@@ -33,6 +36,19 @@ class BinaryPrinter: public PrinterInterface
         write(TBin::host2Net(size));
         output.write(value.c_str(), size);
     }
+    // Position of the size of each array opened with unknownArraySize.
+    // The size is written when it is known (arraySize()) so the stream must be seekable.
+    std::vector<std::streampos>     sizePosition;
+
+    void openUnknownArray()
+    {
+        std::streampos position = output.tellp();
+        if (position == std::streampos(-1))
+        {   throw std::runtime_error("ThorsAnvil::Serialize::BinaryPrinter::openArray: Array of unknown size needs a seekable stream (or a size hint)");
+        }
+        sizePosition.push_back(position);
+        write(TBin::host2Net(static_cast<TBin::BinForm32>(0)));
+    }
     public:
         BinaryPrinter(std::ostream& output, OutputType characteristics = OutputType::Default)
             : PrinterInterface(output, characteristics)
@@ -42,10 +58,29 @@ class BinaryPrinter: public PrinterInterface
 
         virtual void openMap()                              override    {}
         virtual void closeMap()                             override    {}
-        virtual void openArray(std::size_t size)            override    {write(TBin::host2Net(static_cast<TBin::BinForm32>(size)));}
+        virtual void openArray(std::size_t size)            override
+        {
+            if (size == unknownArraySize)
+            {
+                openUnknownArray();
+                return;
+            }
+            write(TBin::host2Net(static_cast<TBin::BinForm32>(size)));
+        }
         virtual void closeArray()                           override    {}
+        virtual void arraySize(std::size_t size)            override
+        {
+            std::streampos  position = output.tellp();
+            output.seekp(sizePosition.back());
+            write(TBin::host2Net(static_cast<TBin::BinForm32>(size)));
+            output.seekp(position);
+            sizePosition.pop_back();
+        }
 
+        using PrinterInterface::addKey;
+        using PrinterInterface::addValue;
         virtual void addKey(std::string const& key)         override    {}
+        virtual void addKey(MemberKey const&)               override    {}
 
         virtual void addValue(short int value)              override    {write(TBin::host2Net(static_cast<TBin::BinForm16>(value)));}
         virtual void addValue(int value)                    override    {write(TBin::host2Net(static_cast<TBin::BinForm32>(value)));}
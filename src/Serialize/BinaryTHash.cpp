@@ -8,6 +8,10 @@
 #include "BinaryTHash.tpp"
 #include "test/THashTest.h"
 #include "test/BinaryParserTest.h"
+#include "SerRange.h"
+#include <functional>
+#include <iterator>
+#include <optional>
 
 
 template std::size_t ThorsAnvil::Serialize::thash<D1>(std::size_t);
@@ -35,6 +39,8 @@ template std::size_t ThorsAnvil::Serialize::thash<Base>(std::size_t);
 template std::size_t ThorsAnvil::Serialize::thash<Derived>(std::size_t);
 
 template std::size_t ThorsAnvil::Serialize::thash<std::vector<int>>(std::size_t);
+template std::size_t ThorsAnvil::Serialize::thash<ThorsAnvil::Serialize::SerializeRange<std::istream_iterator<int>>>(std::size_t);
+template std::size_t ThorsAnvil::Serialize::thash<ThorsAnvil::Serialize::SerializeGenerator<int, std::function<std::optional<int>()>>>(std::size_t);
 
 /*
 template struct ThorsAnvil::Serialize::TraitsHash<short>;
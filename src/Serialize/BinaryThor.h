@@ -9,6 +9,8 @@
  * Usage:
  *      std::cout << binExport(object); // converts object to Binary on an output stream
  *      std::cin  >> binImport(object); // converts Binary to a C++ object from an input stream
+ *      std::cin  >> binReparse(object);// same as binImport() but the object is reset first
+ *      binImportFile(path, object);    // converts Binary in a file (memory mapped) to a C++ object
  */
 
 #include "SerializeConfig.h"
@@ -18,6 +20,9 @@
 #include "BinaryPrinter.h"
 #include "Exporter.h"
 #include "Importer.h"
+#include "MappedFile.h"
+#include <istream>
+#include <string>
 
 namespace ThorsAnvil
 {
@@ -27,17 +32,7 @@ namespace ThorsAnvil
 template<typename T>
 struct Binary
 {
-    private:
-    template<typename X>
-    class BinaryParserWrapper: public BinaryParser<X>
-    {
-        public:
-            BinaryParserWrapper(std::istream& stream, ParserInterface::ParseType /*Ignored*/)
-                : BinaryParser<X>(stream)
-            {}
-    };
-    public:
-    typedef BinaryParserWrapper<T>  Parser;
+    typedef BinaryParser<T>         Parser;
     typedef BinaryPrinter<T>        Printer;
 };
 
@@ -50,6 +45,22 @@ template<typename T>
 Importer<Binary<T>, T> binImport(T& value)
 {
     return Importer<Binary<T>, T>(value, ParserInterface::ParseType::Strict);
+}
+template<typename T>
+Importer<Binary<T>, T> binReparse(T& value)
+{
+    return Importer<Binary<T>, T>(value, ParserInterface::ParseType::Strict, true);
+}
+template<typename T>
+void binImportFile(std::string const& path, T& value)
+{
+    // The binary parser reads fixed size values from a stream.
+    // The stream buffer is the mapped file itself so there is no extra copy.
+    MappedFile      file(path);
+    MemoryStreamBuf buffer(file.data());
+    std::istream    stream(&buffer);
+
+    stream >> binImport(value);
 }
     }
 }
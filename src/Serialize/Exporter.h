@@ -3,6 +3,9 @@
 /*
  * The Exporter simply wrap an object of type T so that when serialized
  * it creates an object of type Serializer and calls it appropriately.
+ *
+ * The Serializer uses the concrete printer type (Format::Printer) so the
+ * calls to the printer for each value are not virtual.
  */
 
 #include "Serialize.h"
@@ -27,7 +30,7 @@ class Exporter
         friend std::ostream& operator<<(std::ostream& stream, Exporter const& data)
         {
             typename Format::Printer    printer(stream, data.characteristics);
-            Serializer                  serializer(printer);
+            BasicSerializer<typename Format::Printer>   serializer(printer);
 
             serializer.print(data.value);
 
@@ -3,9 +3,22 @@
 /*
  * The Importer simply wrap an object of type T so that when de-serialized
  * it creates an object of type DeSerializer and calls it appropriately.
+ *
+ * The DeSerializer uses the concrete parser type (Format::Parser) so the
+ * calls to the parser for each value are not virtual.
+ *
+ * Normally the values read are added to the object (containers are appended to).
+ * With reparse the object is reset first (see resetObject()) so a long lived object
+ * can be refilled while keeping the memory its strings and containers own.
+ *
+ * If a memoryResource is given the object is built from memory allocated by it
+ * (see useMemoryResource()).
  */
 
 #include "Serialize.h"
+#include <stdexcept>
+#include <memory_resource>
+#include <utility>
 
 namespace ThorsAnvil
 {
@@ -17,21 +30,74 @@ class Importer
 {
     T& value;
     ParserInterface::ParseType parseStrictness;
+    bool                       reparse;
+    std::pmr::memory_resource* memoryResource;
     public:
-        Importer(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+        Importer(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak, bool reparse = false, std::pmr::memory_resource* memoryResource = nullptr)
             : value(value)
             , parseStrictness(parseStrictness)
+            , reparse(reparse)
+            , memoryResource(memoryResource)
         {}
         friend std::istream& operator>>(std::istream& stream, Importer const& data)
         {
+            if (data.reparse)
+            {
+                resetObject(data.value);
+            }
             typename Format::Parser     parser(stream, data.parseStrictness);
-            DeSerializer                deSerializer(parser);
+            BasicDeSerializer<typename Format::Parser>  deSerializer(parser, data.memoryResource);
 
             deSerializer.parse(data.value);
             return stream;
         }
 };
 
+/*
+ * Read a top level array one element at a time.
+ * Each element is parsed into the same object (reset to T{} before each element)
+ * which is then passed to action as an rvalue. Memory use does not depend on the
+ * number of elements in the array.
+ * With reparse the object is reset with resetObject() instead, so its strings and
+ * containers keep their memory (unless action moves it away). A member missing from
+ * an element is then V{} rather than its default member initializer.
+ */
+template<typename T, typename Parser, typename F>
+void parseEachElement(Parser& parser, F&& action, bool reparse = false)
+{
+    using ParserToken = ParserInterface::ParserToken;
+
+    // Not a root DeSerializer: DocStart/DocEnd are checked here.
+    BasicDeSerializer<Parser>   deSerializer(parser, false);
+    if (ParserInterface::nextToken(parser) != ParserToken::DocStart)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::parseEachElement: Invalid Doc Start");
+    }
+    if (ParserInterface::nextToken(parser) != ParserToken::ArrayStart)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::parseEachElement: Expecting an Array");
+    }
+
+    T   value{};
+    useParserMemory(parser, value);
+    for (ParserToken token = ParserInterface::nextToken(parser); token != ParserToken::ArrayEnd; token = ParserInterface::nextToken(parser))
+    {
+        parser.pushBackToken(token);
+        if (reparse)
+        {
+            resetObject(value);
+        }
+        else
+        {
+            value   = T{};
+        }
+        deSerializer.parse(value);
+        action(std::move(value));
+    }
+
+    if (ParserInterface::nextToken(parser) != ParserToken::DocEnd)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::parseEachElement: Expected Doc End");
+    }
+}
+
 template<typename Format, typename T>
 Importer<Format, T> Import(T const& value)
 {
@@ -0,0 +1,145 @@
+#include "JsonArrayWriter.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    inline bool isWhiteSpace(char value)    {return value == ' ' || value == '\t' || value == '\n' || value == '\r';}
+
+    /*
+     * Reads a file backwards (a block at a time) one character at a time.
+     */
+    class ReverseReader
+    {
+        std::ifstream       file;
+        std::vector<char>   block;
+        std::streamoff      blockStart;
+        std::size_t         current;
+        public:
+            ReverseReader(std::string const& path)
+                : file(path, std::ios::binary)
+                , block(4096)
+                , blockStart(0)
+                , current(0)
+            {
+                if (file)
+                {
+                    file.seekg(0, std::ios::end);
+                    blockStart = file.tellg();
+                }
+            }
+            // Returns the offset of the previous non white space character (or -1).
+            std::streamoff previousNonSpace(char& value)
+            {
+                for (;;)
+                {
+                    while (current != 0)
+                    {
+                        --current;
+                        if (!isWhiteSpace(block[current]))
+                        {
+                            value = block[current];
+                            return blockStart + current;
+                        }
+                    }
+                    if (blockStart <= 0)
+                    {
+                        return -1;
+                    }
+                    std::streamoff  size = std::min<std::streamoff>(blockStart, block.size());
+                    blockStart -= size;
+                    file.seekg(blockStart);
+                    file.read(block.data(), size);
+                    current = size;
+                }
+            }
+    };
+}
+
+JsonArrayWriter::JsonArrayWriter(std::ostream& stream, PrinterInterface::OutputType characteristics)
+    : printer(stream, characteristics)
+    , finished(false)
+{
+    start(0, false);
+}
+
+JsonArrayWriter::JsonArrayWriter(std::string const& path, Mode mode, PrinterInterface::OutputType characteristics)
+    : printer(file, characteristics)
+    , finished(false)
+{
+    std::streamoff  closePosition   = -1;
+    std::size_t     count           = 0;
+    if (mode == Mode::Append)
+    {
+        ReverseReader   reader(path);
+        char            close;
+        char            last;
+        closePosition   = reader.previousNonSpace(close);
+        if (closePosition != -1)
+        {
+            if (close != ']' || reader.previousNonSpace(last) == -1)
+            {   throw std::runtime_error("ThorsAnvil::Serialize::JsonArrayWriter::JsonArrayWriter: File does not end with a Json array: " + path);
+            }
+            count = (last == '[') ? 0 : 1;
+        }
+    }
+
+    if (closePosition == -1)
+    {
+        file.open(path, std::ios::binary | std::ios::trunc);
+    }
+    else
+    {
+        if (::truncate(path.c_str(), closePosition) != 0)
+        {   throw std::runtime_error("ThorsAnvil::Serialize::JsonArrayWriter::JsonArrayWriter: Failed to truncate file: " + path);
+        }
+        file.open(path, std::ios::binary | std::ios::app);
+    }
+    if (!file)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::JsonArrayWriter::JsonArrayWriter: Failed to open file: " + path);
+    }
+    start(count, closePosition != -1);
+}
+
+JsonArrayWriter::~JsonArrayWriter()
+{
+    try
+    {
+        finish();
+    }
+    catch (...)
+    {
+        // Destructors must not throw.
+        // Call finish() directly to see errors.
+    }
+}
+
+void JsonArrayWriter::start(std::size_t count, bool resume)
+{
+    printer.openDoc();
+    if (resume)
+    {
+        printer.resumeArray(count);
+    }
+    else
+    {
+        printer.openArray(PrinterInterface::unknownArraySize);
+    }
+    printer.flush();
+}
+
+void JsonArrayWriter::finish()
+{
+    if (finished)
+    {
+        return;
+    }
+    finished = true;
+    printer.closeArray();
+    printer.closeDoc();
+    printer.output.flush();
+}
@@ -0,0 +1,67 @@
+#ifndef THORS_ANVIL_SERIALIZE_JSON_ARRAY_WRITER_H
+#define THORS_ANVIL_SERIALIZE_JSON_ARRAY_WRITER_H
+/*
+ * JsonArrayWriter
+ *      Writes a top level Json array one element at a time.
+ *
+ *          JsonArrayWriter     writer("log.json", JsonArrayWriter::Mode::Append);
+ *          writer.append(event1);
+ *          writer.append(event2);
+ *          writer.finish();                // Writes the closing ']'
+ *
+ *      Each element is printed with the normal Serializer and written to the stream
+ *      as soon as it is appended, so at most one element is held in memory.
+ *
+ *      Mode::Append re-opens a file that holds a Json array (e.g. one written by a
+ *      previous JsonArrayWriter). The file is truncated just before its closing ']'
+ *      and new elements are written after the existing ones; nothing else in the
+ *      file is re-written. If the file does not exist (or is empty) a new array is started.
+ *
+ *      If finish() is not called the destructor calls it.
+ */
+
+#include "JsonPrinter.h"
+#include "Serialize.h"
+#include <fstream>
+#include <ostream>
+#include <string>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class JsonArrayWriter
+{
+    public:
+        enum class Mode {Create, Append};
+    private:
+        std::ofstream   file;
+        JsonPrinter     printer;
+        bool            finished;
+
+        void start(std::size_t count, bool resume);
+    public:
+        JsonArrayWriter(std::ostream& stream, PrinterInterface::OutputType characteristics = PrinterInterface::OutputType::Default);
+        JsonArrayWriter(std::string const& path, Mode mode = Mode::Create, PrinterInterface::OutputType characteristics = PrinterInterface::OutputType::Default);
+        ~JsonArrayWriter();
+        JsonArrayWriter(JsonArrayWriter const&)             = delete;
+        JsonArrayWriter& operator=(JsonArrayWriter const&)  = delete;
+
+        template<typename T>
+        void append(T const& value)
+        {
+            if (finished)
+            {   throw std::runtime_error("ThorsAnvil::Serialize::JsonArrayWriter::append: Array has been finished");
+            }
+            BasicSerializer<JsonPrinter>    serializer(printer, false);
+            serializer.print(value);
+            printer.flush();
+        }
+        void finish();
+};
+
+    }
+}
+
+#endif
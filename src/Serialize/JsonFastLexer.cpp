@@ -0,0 +1,488 @@
+#include "JsonFastLexer.h"
+#include "JsonLexemes.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+#if defined(__AVX2__)
+    using Block = __m256i;
+    constexpr std::size_t   blockWidth = 32;
+    constexpr std::uint32_t allBits    = 0xFFFFFFFF;
+    inline Block            load(char const* src)           {return _mm256_loadu_si256(reinterpret_cast<Block const*>(src));}
+    inline Block            splat(char value)               {return _mm256_set1_epi8(value);}
+    inline Block            match(Block lhs, Block rhs)     {return _mm256_cmpeq_epi8(lhs, rhs);}
+    inline Block            either(Block lhs, Block rhs)    {return _mm256_or_si256(lhs, rhs);}
+    inline std::uint32_t    bits(Block value)               {return static_cast<std::uint32_t>(_mm256_movemask_epi8(value));}
+    #define THORS_JSON_FAST_LEXER_SIMD
+#elif defined(__SSE2__)
+    using Block = __m128i;
+    constexpr std::size_t   blockWidth = 16;
+    constexpr std::uint32_t allBits    = 0x0000FFFF;
+    inline Block            load(char const* src)           {return _mm_loadu_si128(reinterpret_cast<Block const*>(src));}
+    inline Block            splat(char value)               {return _mm_set1_epi8(value);}
+    inline Block            match(Block lhs, Block rhs)     {return _mm_cmpeq_epi8(lhs, rhs);}
+    inline Block            either(Block lhs, Block rhs)    {return _mm_or_si128(lhs, rhs);}
+    inline std::uint32_t    bits(Block value)               {return static_cast<std::uint32_t>(_mm_movemask_epi8(value));}
+    #define THORS_JSON_FAST_LEXER_SIMD
+#endif
+
+    // Matches the flex definition: WHITESPACE [ \t\n\r]
+    inline bool isWhiteSpace(char value)    {return value == ' ' || value == '\t' || value == '\n' || value == '\r';}
+    inline bool isDigit(char value)         {return value >= '0' && value <= '9';}
+    inline bool isHexDigit(char value)      {return isDigit(value) || (value >= 'a' && value <= 'f') || (value >= 'A' && value <= 'F');}
+
+    /*
+     * The wide loops only load complete blocks that are inside [current, end).
+     * What is left over (less than a block) is done by the scalar loop.
+     */
+    char const* findNonWhiteSpace(char const* current, char const* end)
+    {
+#ifdef THORS_JSON_FAST_LEXER_SIMD
+        Block const space   = splat(' ');
+        Block const tab     = splat('\t');
+        Block const newLine = splat('\n');
+        Block const cr      = splat('\r');
+        while (end - current >= static_cast<std::ptrdiff_t>(blockWidth))
+        {
+            Block           data    = load(current);
+            Block           white   = either(either(match(data, space), match(data, tab)), either(match(data, newLine), match(data, cr)));
+            std::uint32_t   other   = ~bits(white) & allBits;
+            if (other != 0)
+            {
+                return current + __builtin_ctz(other);
+            }
+            current += blockWidth;
+        }
+#endif
+        while (current < end && isWhiteSpace(*current))
+        {
+            ++current;
+        }
+        return current;
+    }
+
+    char const* findQuoteOrEscape(char const* current, char const* end)
+    {
+#ifdef THORS_JSON_FAST_LEXER_SIMD
+        Block const quote   = splat('"');
+        Block const escape  = splat('\\');
+        while (end - current >= static_cast<std::ptrdiff_t>(blockWidth))
+        {
+            Block           data    = load(current);
+            std::uint32_t   found   = bits(either(match(data, quote), match(data, escape)));
+            if (found != 0)
+            {
+                return current + __builtin_ctz(found);
+            }
+            current += blockWidth;
+        }
+#endif
+        while (current < end && *current != '"' && *current != '\\')
+        {
+            ++current;
+        }
+        return current;
+    }
+
+    inline bool isStructural(char value)    {return value == '{' || value == '}' || value == '[' || value == ']' || value == '"';}
+
+    char const* findStructural(char const* current, char const* end)
+    {
+#ifdef THORS_JSON_FAST_LEXER_SIMD
+        Block const openM   = splat('{');
+        Block const closeM  = splat('}');
+        Block const openA   = splat('[');
+        Block const closeA  = splat(']');
+        Block const quote   = splat('"');
+        while (end - current >= static_cast<std::ptrdiff_t>(blockWidth))
+        {
+            Block           data    = load(current);
+            Block           brace   = either(match(data, openM), match(data, closeM));
+            Block           bracket = either(match(data, openA), match(data, closeA));
+            std::uint32_t   found   = bits(either(either(brace, bracket), match(data, quote)));
+            if (found != 0)
+            {
+                return current + __builtin_ctz(found);
+            }
+            current += blockWidth;
+        }
+#endif
+        while (current < end && !isStructural(*current))
+        {
+            ++current;
+        }
+        return current;
+    }
+}
+
+JsonFastLexer::JsonFastLexer(std::istream* input)
+    : input(input)
+    , cursor(nullptr)
+    , end(nullptr)
+    , tokenStart(nullptr)
+    , tokenSize(0)
+    , eof(false)
+    , seekable(false)
+{}
+
+JsonFastLexer::JsonFastLexer(std::string_view input)
+    : input(nullptr)
+    , cursor(input.data())
+    , end(input.data() + input.size())
+    , tokenStart(cursor)
+    , tokenSize(0)
+    , eof(true)
+    , seekable(false)
+{}
+
+void JsonFastLexer::reset(std::string_view data)
+{
+    input       = nullptr;
+    cursor      = data.data();
+    end         = data.data() + data.size();
+    tokenStart  = cursor;
+    tokenSize   = 0;
+    eof         = true;
+    seekable    = false;
+}
+
+void JsonFastLexer::error()
+{
+    throw std::runtime_error("ThorsAnvil::Serialize::JsonFastLexer: Invalid Character in Lexer");
+}
+
+/*
+ * Read the next block from the stream.
+ * Anything from the start of the current token is kept (moved to the front of
+ * the buffer) so that YYText() always refers to a contiguous piece of memory.
+ * `current` and the token pointers are updated to point into the new buffer.
+ */
+bool JsonFastLexer::fill(char const*& current)
+{
+    if (eof || input == nullptr)
+    {
+        return false;
+    }
+
+    if (buffer.empty())
+    {
+        seekable = input->tellg() != std::streampos(-1);
+    }
+
+    std::size_t keep    = end - tokenStart;
+    std::size_t offset  = current - tokenStart;
+    if (keep != 0 && tokenStart != buffer.data())
+    {
+        std::memmove(buffer.data(), tokenStart, keep);
+    }
+    if (buffer.size() < keep + BlockSize)
+    {
+        buffer.resize(keep + BlockSize);
+    }
+
+    input->read(buffer.data() + keep, BlockSize);
+    std::size_t count   = input->gcount();
+    eof                 = count == 0;
+
+    tokenStart  = buffer.data();
+    current     = tokenStart + offset;
+    end         = tokenStart + keep + count;
+
+    return !eof;
+}
+
+void JsonFastLexer::release()
+{
+    if (input == nullptr)
+    {
+        return;
+    }
+    // Reading a short block sets the fail bit. But running out of input
+    // is not a failure, so only report eof (like reading an int at the end of a stream).
+    if (input->eof())
+    {
+        input->clear(input->rdstate() & ~std::ios_base::failbit);
+    }
+    std::size_t unused = end - cursor;
+    if (unused != 0 && seekable)
+    {
+        input->clear();
+        input->seekg(-static_cast<std::streamoff>(unused), std::ios_base::cur);
+    }
+    end = cursor;
+    eof = false;
+}
+
+bool JsonFastLexer::ensure(char const*& current, std::size_t size)
+{
+    while (static_cast<std::size_t>(end - current) < size)
+    {
+        if (!fill(current))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+char const* JsonFastLexer::skipWhiteSpace(char const* current)
+{
+    for (;;)
+    {
+        current     = findNonWhiteSpace(current, end);
+        tokenStart  = current;
+        if (current != end || !fill(current))
+        {
+            return current;
+        }
+    }
+}
+
+char const* JsonFastLexer::scanLiteral(char const* current, char const* literal, std::size_t size)
+{
+    if (!ensure(current, size) || std::memcmp(current, literal, size) != 0)
+    {
+        error();
+    }
+    return current + size;
+}
+
+/*
+ * Matches the flex definitions:
+ *      INTNUM  [1-9][0-9]*                                 => JSON_INTEGER
+ *      NUMBER  -?([1-9][0-9]*|0)(\.[0-9]+)?([eE][+-]?[0-9]+)? => JSON_FLOAT
+ * A trailing '.' or 'e' that is not followed by digits is not part of the number.
+ */
+char const* JsonFastLexer::scanNumber(char const* current, int& token)
+{
+    bool    integer = true;
+    if (*current == '-')
+    {
+        integer = false;
+        ++current;
+    }
+    if (!ensure(current, 1))
+    {
+        error();
+    }
+    if (*current == '0')
+    {
+        integer = false;
+        ++current;
+    }
+    else if (isDigit(*current))
+    {
+        do
+        {
+            ++current;
+        }
+        while (ensure(current, 1) && isDigit(*current));
+    }
+    else
+    {
+        error();
+    }
+
+    if (ensure(current, 2) && current[0] == '.' && isDigit(current[1]))
+    {
+        integer = false;
+        current += 2;
+        while (ensure(current, 1) && isDigit(*current))
+        {
+            ++current;
+        }
+    }
+    if (ensure(current, 2) && (current[0] == 'e' || current[0] == 'E'))
+    {
+        std::size_t sign    = (current[1] == '+' || current[1] == '-') ? 1 : 0;
+        if (ensure(current, 2 + sign) && isDigit(current[1 + sign]))
+        {
+            integer = false;
+            current += 2 + sign;
+            while (ensure(current, 1) && isDigit(*current))
+            {
+                ++current;
+            }
+        }
+    }
+    token = integer ? JSON_INTEGER : JSON_FLOAT;
+    return current;
+}
+
+/*
+ * Matches the flex definition:
+ *      STRING  \"([^"\\]|\\["\\/bfnrt]|\\u[A-Fa-f0-9]{4})*\"
+ */
+char const* JsonFastLexer::scanString(char const* current)
+{
+    ++current;
+    for (;;)
+    {
+        current = findQuoteOrEscape(current, end);
+        if (current == end)
+        {
+            if (!fill(current))
+            {
+                error();
+            }
+            continue;
+        }
+        if (*current == '"')
+        {
+            return current + 1;
+        }
+        if (!ensure(current, 2))
+        {
+            error();
+        }
+        switch (current[1])
+        {
+            case '"':   case '\\':  case '/':
+            case 'b':   case 'f':   case 'n':   case 'r':   case 't':
+                current += 2;
+                break;
+            case 'u':
+                if (!ensure(current, 6) || !isHexDigit(current[2]) || !isHexDigit(current[3]) || !isHexDigit(current[4]) || !isHexDigit(current[5]))
+                {
+                    error();
+                }
+                current += 6;
+                break;
+            default:
+                error();
+        }
+    }
+}
+
+/*
+ * Skip a complete value without generating tokens.
+ * Maps and arrays are skipped by counting brackets. Strings are scanned with
+ * scanString() so brackets inside strings are ignored and escapes are checked.
+ * Nothing else inside the value is validated.
+ * Data that has been skipped is not kept in the buffer.
+ */
+void JsonFastLexer::skipValue()
+{
+    char const* current = skipWhiteSpace(cursor);
+    if (current == end || (*current != '{' && *current != '['))
+    {
+        if (yylex() < JSON_STRING)
+        {
+            error();
+        }
+        return;
+    }
+
+    std::size_t depth = 0;
+    do
+    {
+        tokenStart  = current;
+        current     = findStructural(current, end);
+        if (current == end)
+        {
+            tokenStart = current;
+            if (!fill(current))
+            {
+                error();
+            }
+            continue;
+        }
+        switch (*current)
+        {
+            case '{':   case '[':   ++depth; ++current;             break;
+            case '}':   case ']':   --depth; ++current;             break;
+            default:    tokenStart = current; current = scanString(current); break;
+        }
+    }
+    while (depth != 0);
+
+    tokenStart  = current;
+    tokenSize   = 0;
+    cursor      = current;
+}
+
+/*
+ * Count the values in the map or array that has just been opened (the cursor is
+ * just after the '{' or '['): the commas that are not nested plus one.
+ * Nothing is read from the stream and at most limit bytes are looked at; if the
+ * closing bracket is not found in that range the count is unknown and 0 is returned.
+ */
+std::size_t JsonFastLexer::countValues(std::size_t limit) const
+{
+    char const* current = findNonWhiteSpace(cursor, end);
+    char const* last    = (static_cast<std::size_t>(end - current) > limit) ? current + limit : end;
+    if (current == last || *current == ']' || *current == '}')
+    {
+        return 0;
+    }
+
+    std::size_t count   = 1;
+    std::size_t depth   = 0;
+    for (; current < last; ++current)
+    {
+        switch (*current)
+        {
+            case '{':   case '[':   ++depth;                    break;
+            case '}':   case ']':
+                if (depth == 0)
+                {
+                    return count;
+                }
+                --depth;
+                break;
+            case ',':   count += (depth == 0) ? 1 : 0;          break;
+            case '"':
+                for (++current; current < last && *current != '"'; ++current)
+                {
+                    current += (*current == '\\') ? 1 : 0;
+                }
+                break;
+        }
+    }
+    return 0;
+}
+
+int JsonFastLexer::yylex()
+{
+    char const* current = skipWhiteSpace(cursor);
+    if (current == end)
+    {
+        cursor      = current;
+        tokenSize   = 0;
+        return 0;
+    }
+
+    int token;
+    switch (*current)
+    {
+        case '{':   case '}':   case '[':   case ']':   case ',':   case ':':
+            token   = *current;
+            ++current;
+            break;
+        case 't':   current = scanLiteral(current, "true",  4);   token = JSON_TRUE;  break;
+        case 'f':   current = scanLiteral(current, "false", 5);   token = JSON_FALSE; break;
+        case 'n':   current = scanLiteral(current, "null",  4);   token = JSON_NULL;  break;
+        case '"':   current = scanString(current);                  token = JSON_STRING;break;
+        case '-':
+        case '0':   case '1':   case '2':   case '3':   case '4':
+        case '5':   case '6':   case '7':   case '8':   case '9':
+            current = scanNumber(current, token);
+            break;
+        default:
+            error();
+    }
+    tokenSize   = current - tokenStart;
+    cursor      = current;
+    return token;
+}
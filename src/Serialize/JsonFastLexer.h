@@ -0,0 +1,90 @@
+#ifndef THORS_ANVIL_SERIALIZE_JSON_FAST_LEXER_H
+#define THORS_ANVIL_SERIALIZE_JSON_FAST_LEXER_H
+/*
+ * JsonFastLexer
+ *      A hand written replacement for the flex generated JsonLexerFlexLexer.
+ *
+ *      It has the same interface as the flex lexer (yylex()/YYText()/YYLeng())
+ *      and returns the same tokens (see JsonLexemes.h) so JsonParser can use
+ *      either backend with the same state table.
+ *
+ *      Rather than stepping a DFA one byte at a time the lexer works on a
+ *      contiguous buffer and uses SIMD compares to find the "interesting"
+ *      characters. Whitespace runs are skipped and string bodies are scanned
+ *      for the closing quote or an escape 16 (SSE2) or 32 (AVX2) bytes at a
+ *      time. When neither instruction set is available at compile time a
+ *      scalar loop is used.
+ *
+ *      The input can be a stream (read in blocks into an internal buffer) or
+ *      a contiguous block of memory that is scanned in place without copying.
+ *      The wide loads never read past the end of the data; the last partial
+ *      block is handled by the scalar loop.
+ *
+ *      Tokens are not null terminated; use YYLeng() to find the end.
+ *
+ *      skipValue() jumps over a complete value (including nested maps and arrays)
+ *      by matching brackets and quotes directly in the buffer without creating tokens.
+ *      countValues() uses the same idea to count the values in the map/array that
+ *      has just been opened, but only looks at the data already in memory.
+ *
+ *      The flex lexer reads the stream one character at a time so it leaves the
+ *      stream just after the last token. This lexer reads in blocks, so when the
+ *      parser is finished release() hands back the unused input by seeking the
+ *      stream backwards. A block read also waits until the block is full or the
+ *      stream ends. So this lexer is only suitable for memory and for streams that
+ *      can seek (files and string streams); JsonParser uses the flex lexer for any
+ *      other stream (pipes, sockets, a terminal).
+ */
+
+#include <istream>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class JsonFastLexer
+{
+    public:
+        static constexpr std::size_t    BlockSize   = 64 * 1024;
+
+    private:
+        std::istream*       input;
+        std::vector<char>   buffer;
+        char const*         cursor;
+        char const*         end;
+        char const*         tokenStart;
+        std::size_t         tokenSize;
+        bool                eof;
+        bool                seekable;
+
+        bool        fill(char const*& current);
+        char const* skipWhiteSpace(char const* current);
+        char const* scanString(char const* current);
+        char const* scanNumber(char const* current, int& token);
+        char const* scanLiteral(char const* current, char const* literal, std::size_t size);
+        bool        ensure(char const*& current, std::size_t size);
+        [[noreturn]] void error();
+    public:
+        JsonFastLexer(std::istream* input);
+        JsonFastLexer(std::string_view input);
+
+        // Start again on a new block of memory (the buffer is kept for reuse).
+        void        reset(std::string_view input);
+
+        int         yylex();
+        void        skipValue();
+        std::size_t countValues(std::size_t limit) const;
+        void        release();
+        char const* position() const{return cursor;}
+        char const* YYText() const  {return tokenStart;}
+        int         YYLeng() const  {return static_cast<int>(tokenSize);}
+};
+
+    }
+}
+
+#endif
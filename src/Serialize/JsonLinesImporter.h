@@ -0,0 +1,195 @@
+#ifndef THORS_ANVIL_SERIALIZE_JSON_LINES_IMPORTER_H
+#define THORS_ANVIL_SERIALIZE_JSON_LINES_IMPORTER_H
+/*
+ * JsonLinesImporter<T>
+ *      Reads a stream of Json lines (NDJSON): one Json document per line.
+ *      It is a single pass input range that yields one T for each line.
+ *
+ *          for (auto& event: jsonLinesImport<Event>(stream))
+ *          {
+ *              // Use event
+ *          }
+ *
+ *      A single JsonParser, line buffer and object are used for all the lines.
+ *      The object is reset to T{} before each line is parsed, so the yielded value is
+ *      only valid until the iterator is incremented (you may move from it).
+ *      With reparse the object is reset with resetObject() instead, so its strings and
+ *      containers keep their memory between lines (a member missing from a line is then
+ *      V{} rather than its default member initializer).
+ *
+ *      Empty lines are ignored. Only white space may follow the Json document on a line.
+ *      A line that can not be parsed throws (BadLine::Throw) or is skipped and
+ *      counted (BadLine::Skip) so the rest of the stream can still be read.
+ *
+ *      For Json lines held in memory see also jsonLinesImportParallel() (JsonParallelImport.h).
+ */
+
+#include "JsonParser.h"
+#include "Serialize.h"
+#include <istream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+enum class JsonBadLine {Throw, Skip};
+
+/*
+ * Lines that only contain white space are ignored.
+ */
+inline bool jsonBlankLine(std::string_view line)
+{
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+/*
+ * Parse a single Json document from the start of data into value (as it is: value is not reset).
+ * The parser is reset onto data so it can be reused.
+ * Anything after the document is not read (see JsonParser::position()).
+ */
+template<typename T>
+void jsonParseElement(JsonParser& parser, std::string_view data, T& value)
+{
+    using ParserToken = ParserInterface::ParserToken;
+
+    parser.reset(data);
+
+    // Not a root DeSerializer: a bad line must not throw from a destructor.
+    BasicDeSerializer<JsonParser>   deSerializer(parser, false);
+    if (ParserInterface::nextToken(parser) != ParserToken::DocStart)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::jsonParseElement: Invalid Doc Start");
+    }
+    deSerializer.parse(value);
+    if (ParserInterface::nextToken(parser) != ParserToken::DocEnd)
+    {   throw std::runtime_error("ThorsAnvil::Serialize::jsonParseElement: Expected Doc End");
+    }
+}
+
+/*
+ * Parse a single Json document (one line) into value.
+ * value is reset to T{} first (or with resetObject() if reparse is true).
+ * Only white space may follow the document on the line.
+ */
+template<typename T>
+void jsonParseLine(JsonParser& parser, std::string_view line, T& value, bool reparse = false)
+{
+    if (reparse)
+    {
+        resetObject(value);
+    }
+    else
+    {
+        value   = T{};
+    }
+    jsonParseElement(parser, line, value);
+
+    char const* rest = parser.position();
+    if (!jsonBlankLine(std::string_view(rest, line.data() + line.size() - rest)))
+    {   throw std::runtime_error("ThorsAnvil::Serialize::jsonParseLine: Unexpected data after the document");
+    }
+}
+
+template<typename T>
+class JsonLinesImporter
+{
+    public:
+        using BadLine = JsonBadLine;
+
+        class iterator
+        {
+            JsonLinesImporter*  importer;
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type        = T;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = T*;
+                using reference         = T&;
+
+                iterator(JsonLinesImporter* importer = nullptr)
+                    : importer(importer)
+                {}
+                T& operator*() const                                {return importer->value;}
+                T* operator->() const                               {return &importer->value;}
+                iterator& operator++()
+                {
+                    if (!importer->next())
+                    {
+                        importer = nullptr;
+                    }
+                    return *this;
+                }
+                friend bool operator==(iterator const& lhs, iterator const& rhs)   {return lhs.importer == rhs.importer;}
+                friend bool operator!=(iterator const& lhs, iterator const& rhs)   {return lhs.importer != rhs.importer;}
+        };
+
+    private:
+        std::istream&       stream;
+        JsonParser          parser;
+        BadLine             badLine;
+        bool                reparse;
+        std::string         line;
+        T                   value;
+        std::size_t         lineCount;
+        std::size_t         badLineCount;
+
+        bool next()
+        {
+            while (std::getline(stream, line))
+            {
+                ++lineCount;
+                if (jsonBlankLine(line))
+                {
+                    continue;
+                }
+                try
+                {
+                    jsonParseLine(parser, line, value, reparse);
+                    return true;
+                }
+                catch (std::system_error const&)
+                {
+                    throw;
+                }
+                catch (std::runtime_error const& e)
+                {
+                    // Parse errors only: anything else (eg std::bad_alloc) is passed on.
+                    if (badLine == BadLine::Throw)
+                    {
+                        throw std::runtime_error("ThorsAnvil::Serialize::JsonLinesImporter::next: Line " + std::to_string(lineCount) + ": " + e.what());
+                    }
+                    ++badLineCount;
+                }
+            }
+            return false;
+        }
+
+    public:
+        JsonLinesImporter(std::istream& stream, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak, BadLine badLine = BadLine::Throw, bool reparse = false)
+            : stream(stream)
+            , parser(std::string_view(), parseStrictness)
+            , badLine(badLine)
+            , reparse(reparse)
+            , value()
+            , lineCount(0)
+            , badLineCount(0)
+        {}
+
+        // Single pass: begin() reads the first line.
+        iterator    begin()                 {return next() ? iterator(this) : iterator();}
+        iterator    end()                   {return iterator();}
+
+        std::size_t lines() const           {return lineCount;}
+        std::size_t badLines() const        {return badLineCount;}
+};
+
+    }
+}
+
+#endif
@@ -0,0 +1,404 @@
+#ifndef THORS_ANVIL_SERIALIZE_JSON_PARALLEL_IMPORT_H
+#define THORS_ANVIL_SERIALIZE_JSON_PARALLEL_IMPORT_H
+/*
+ * Multi-threaded Json import of data held in memory (see jsonImport(std::string_view) / MappedFile).
+ *
+ *      jsonLinesImportParallel(data, result)
+ *          data is a block of Json lines (NDJSON).
+ *          The data is split into one chunk per thread (on line boundaries).
+ *          Each thread has its own JsonParser and parses its chunk into a local vector.
+ *          The local vectors are then moved (in order) onto the end of result.
+ *
+ *          Returns the number of bad lines that were skipped (JsonBadLine::Skip).
+ *          With JsonBadLine::Throw the first bad line (in input order) is reported.
+ *          Only parse errors make a bad line; other exceptions (eg std::bad_alloc) are
+ *          rethrown on the calling thread.
+ *
+ *      jsonImportArrayParallel(data, result)
+ *          data is a single Json array.
+ *          The text is scanned on the current thread to find the commas between elements
+ *          (strings and nested objects/arrays are skipped) and split into one chunk per thread.
+ *          Each chunk is parsed as a list of elements on its own thread. The scan does not check
+ *          the Json, so if any chunk fails to parse the whole array is parsed again on the current
+ *          thread (so errors are reported exactly as jsonImport() would report them).
+ *          Returns true if the parallel parse was used.
+ *
+ *      Note: this uses std::thread so the application needs to link with the
+ *            thread library (-pthread).
+ */
+
+#include "JsonThor.h"
+#include "JsonLinesImporter.h"
+#include "JsonParser.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+/*
+ * Split data into (at most) count pieces.
+ * Each piece ends just after a '\n' (apart from the last) so no line is split.
+ */
+inline std::vector<std::string_view> jsonSplitLines(std::string_view data, std::size_t count)
+{
+    std::vector<std::string_view>   result;
+    std::size_t const               target  = std::max<std::size_t>(1, data.size() / std::max<std::size_t>(1, count));
+
+    while (!data.empty())
+    {
+        std::size_t size    = std::min(target, data.size());
+        char const* newLine = static_cast<char const*>(std::memchr(data.data() + size - 1, '\n', data.size() - size + 1));
+        size                = newLine == nullptr ? data.size() : newLine - data.data() + 1;
+
+        result.emplace_back(data.substr(0, size));
+        data.remove_prefix(size);
+    }
+    return result;
+}
+
+inline bool jsonIsSpace(char value)     {return value == ' ' || value == '\t' || value == '\n' || value == '\r';}
+
+/*
+ * quote is the opening '"' of a string.
+ * Returns the character after the closing '"' (end if the string is not closed).
+ */
+inline char const* jsonSkipString(char const* quote, char const* end)
+{
+    for (char const* next = quote + 1; (next = static_cast<char const*>(std::memchr(next, '"', end - next))) != nullptr; ++next)
+    {
+        // The quote is escaped if it follows an odd number of '\'.
+        char const* slash = next;
+        while (slash[-1] == '\\')
+        {
+            --slash;
+        }
+        if ((next - slash) % 2 == 0)
+        {
+            return next + 1;
+        }
+    }
+    return end;
+}
+
+/*
+ * Split the inside of an array into at most count pieces of (roughly) the same size.
+ * The text is scanned from the start of the array keeping track of strings and nested
+ * objects/arrays, so a piece only ends at a comma between two elements of the array.
+ * The scan does not validate the Json (the parse of each piece does that).
+ */
+inline std::vector<std::string_view> jsonSplitElements(char const* begin, char const* end, std::size_t count)
+{
+    std::vector<std::string_view>   result;
+    std::size_t const               target  = std::max<std::size_t>(1, (end - begin) / std::max<std::size_t>(1, count));
+
+    char const*     current = begin;
+    char const*     loop    = begin;
+    std::size_t     depth   = 0;
+    while (loop != end && result.size() + 1 < count)
+    {
+        switch (*loop)
+        {
+            case '"':   loop = jsonSkipString(loop, end); continue;
+            case '{':
+            case '[':   ++depth; break;
+            case '}':
+            case ']':
+                if (depth != 0)
+                {
+                    --depth;
+                }
+                break;
+            case ',':
+                if (depth == 0 && static_cast<std::size_t>(loop - current) >= target)
+                {
+                    result.emplace_back(current, loop - current);
+                    current = loop + 1;
+                }
+                break;
+        }
+        ++loop;
+    }
+    // The last piece is added even if it is empty: "[1,]" must not parse.
+    result.emplace_back(current, end - current);
+    return result;
+}
+
+template<typename T>
+class JsonLinesChunk
+{
+    public:
+        std::vector<T>      values;
+        std::size_t         lineCount       = 0;
+        std::size_t         badLineCount    = 0;
+        std::size_t         errorLine       = 0;
+        std::string         errorMessage;
+
+        // Parse a comma separated list of Json elements (the inside of an array).
+        bool parseElements(std::string_view data, ParserInterface::ParseType parseStrictness)
+        {
+            JsonParser      parser(std::string_view(), parseStrictness);
+            char const*     current = data.data();
+            char const*     end     = data.data() + data.size();
+
+            try
+            {
+                for (;;)
+                {
+                    // Each element starts from T{} (as it does with jsonImport()).
+                    T       value{};
+                    jsonParseElement(parser, std::string_view(current, end - current), value);
+                    values.emplace_back(std::move(value));
+
+                    current = parser.position();
+                    while (current != end && jsonIsSpace(*current))
+                    {
+                        ++current;
+                    }
+                    if (current == end)
+                    {
+                        return true;
+                    }
+                    if (*current != ',')
+                    {
+                        return false;
+                    }
+                    ++current;
+                }
+            }
+            catch (std::system_error const&)
+            {
+                throw;
+            }
+            catch (std::runtime_error const&)
+            {
+                // Parse errors only: anything else (eg std::bad_alloc) is passed on.
+                return false;
+            }
+        }
+
+        void parse(std::string_view data, ParserInterface::ParseType parseStrictness, JsonBadLine badLine)
+        {
+            JsonParser      parser(std::string_view(), parseStrictness);
+            T               value;
+
+            while (!data.empty())
+            {
+                std::size_t         size    = std::min(data.find('\n'), data.size());
+                std::string_view    line    = data.substr(0, size);
+                data.remove_prefix(std::min(size + 1, data.size()));
+
+                ++lineCount;
+                if (jsonBlankLine(line))
+                {
+                    continue;
+                }
+                try
+                {
+                    jsonParseLine(parser, line, value);
+                    values.emplace_back(std::move(value));
+                }
+                catch (std::system_error const&)
+                {
+                    throw;
+                }
+                catch (std::runtime_error const& e)
+                {
+                    // Parse errors only: anything else (eg std::bad_alloc) is passed on.
+                    if (badLine == JsonBadLine::Throw)
+                    {
+                        errorLine       = lineCount;
+                        errorMessage    = e.what();
+                        return;
+                    }
+                    ++badLineCount;
+                }
+            }
+        }
+};
+
+/*
+ * The threads started for one import (at most count).
+ * They are joined by the destructor, so if starting a thread or the work done on the
+ * current thread throws, no std::thread is destroyed while still joinable.
+ * An exception that escapes from the work of a thread is kept and rethrown by finish().
+ */
+class JsonWorkers
+{
+    std::vector<std::thread>            workers;
+    std::vector<std::exception_ptr>     failures;
+    public:
+        JsonWorkers(std::size_t count)
+            : failures(count)
+        {
+            workers.reserve(count);
+        }
+        ~JsonWorkers()
+        {
+            join();
+        }
+        template<typename F>
+        void start(F&& work)
+        {
+            std::exception_ptr&     failure = failures.at(workers.size());
+            workers.emplace_back([&failure, work = std::forward<F>(work)]() mutable
+            {
+                try
+                {
+                    work();
+                }
+                catch (...)
+                {
+                    failure = std::current_exception();
+                }
+            });
+        }
+        void finish()
+        {
+            join();
+            for (auto const& failure: failures)
+            {
+                if (failure)
+                {
+                    std::rethrow_exception(failure);
+                }
+            }
+        }
+        void join()
+        {
+            for (auto& worker: workers)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+        }
+};
+
+template<typename T>
+std::size_t jsonLinesImportParallel(std::string_view data, std::vector<T>& result,
+                                    ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak,
+                                    JsonBadLine badLine = JsonBadLine::Throw,
+                                    std::size_t threadCount = std::thread::hardware_concurrency())
+{
+    std::vector<std::string_view>   pieces  = jsonSplitLines(data, threadCount);
+    std::vector<JsonLinesChunk<T>>  chunks(pieces.size());
+    JsonWorkers                     workers(pieces.size());
+
+    for (std::size_t loop = 1; loop < pieces.size(); ++loop)
+    {
+        workers.start([&chunks, &pieces, loop, parseStrictness, badLine]()
+        {
+            chunks[loop].parse(pieces[loop], parseStrictness, badLine);
+        });
+    }
+    // The current thread does the first chunk.
+    if (!pieces.empty())
+    {
+        chunks[0].parse(pieces[0], parseStrictness, badLine);
+    }
+    workers.finish();
+
+    std::size_t     lineCount       = 0;
+    std::size_t     badLineCount    = 0;
+    std::size_t     valueCount      = 0;
+    for (auto const& chunk: chunks)
+    {
+        if (chunk.errorLine != 0)
+        {
+            throw std::runtime_error("ThorsAnvil::Serialize::jsonLinesImportParallel: Line " + std::to_string(lineCount + chunk.errorLine) + ": " + chunk.errorMessage);
+        }
+        lineCount       += chunk.lineCount;
+        badLineCount    += chunk.badLineCount;
+        valueCount      += chunk.values.size();
+    }
+
+    result.reserve(result.size() + valueCount);
+    for (auto& chunk: chunks)
+    {
+        std::move(std::begin(chunk.values), std::end(chunk.values), std::back_inserter(result));
+    }
+    return badLineCount;
+}
+
+template<typename T>
+bool jsonImportArrayParallel(std::string_view data, std::vector<T>& result,
+                             ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak,
+                             std::size_t threadCount = std::thread::hardware_concurrency())
+{
+    char const*     begin   = data.data();
+    char const*     end     = data.data() + data.size();
+    while (begin != end && jsonIsSpace(*begin))
+    {
+        ++begin;
+    }
+    while (begin != end && jsonIsSpace(end[-1]))
+    {
+        --end;
+    }
+
+    std::vector<std::string_view>   pieces;
+    if (end - begin >= 2 && *begin == '[' && end[-1] == ']')
+    {
+        ++begin;
+        --end;
+        pieces = jsonSplitElements(begin, end, threadCount);
+    }
+
+    // Speculation is only worth it if the data was split.
+    bool    parallel = pieces.size() > 1;
+    if (parallel)
+    {
+        std::vector<JsonLinesChunk<T>>  chunks(pieces.size());
+        std::vector<char>               good(pieces.size(), false);
+        JsonWorkers                     workers(pieces.size());
+
+        for (std::size_t loop = 1; loop < pieces.size(); ++loop)
+        {
+            workers.start([&chunks, &pieces, &good, loop, parseStrictness]()
+            {
+                good[loop] = chunks[loop].parseElements(pieces[loop], parseStrictness);
+            });
+        }
+        good[0] = chunks[0].parseElements(pieces[0], parseStrictness);
+        workers.finish();
+
+        parallel = std::find(std::begin(good), std::end(good), false) == std::end(good);
+        if (parallel)
+        {
+            std::size_t valueCount = 0;
+            for (auto const& chunk: chunks)
+            {
+                valueCount += chunk.values.size();
+            }
+            result.reserve(result.size() + valueCount);
+            for (auto& chunk: chunks)
+            {
+                std::move(std::begin(chunk.values), std::end(chunk.values), std::back_inserter(result));
+            }
+        }
+    }
+    if (!parallel)
+    {
+        jsonImport(data, result, parseStrictness);
+    }
+    return parallel;
+}
+
+    }
+}
+
+#endif
@@ -1,7 +1,6 @@
 #include "JsonParser.h"
 #include "JsonLexemes.h"
 #include "UnicodeIterator.h"
-#include <map>
 #include <cstdlib>
 #include <cstring>
 
@@ -9,14 +8,107 @@
 using namespace ThorsAnvil::Serialize;
 using ParserToken = ParserInterface::ParserToken;
 
-JsonParser::JsonParser(std::istream& stream, ParseType parseStrictness)
+namespace
+{
+    // Convert Lexer tokens into the smaller range 0-12 used by the state table.
+    // The lexer tokens are either characters or the values in JsonLexemes.h so
+    // a flat array covers all of them. Anything unknown maps to 0 (Error).
+    struct TokenIndexTable
+    {
+        static constexpr int    size = JSON_NULL + 1;
+        unsigned char           index[size];
+
+        constexpr TokenIndexTable()
+            : index{}
+        {
+            index['{']          = 1;
+            index['}']          = 2;
+            index['[']          = 3;
+            index[']']          = 4;
+            index[',']          = 5;
+            index[':']          = 6;
+            index[JSON_TRUE]    = 7;
+            index[JSON_FALSE]   = 8;
+            index[JSON_NULL]    = 9;
+            index[JSON_STRING]  = 10;
+            index[JSON_INTEGER] = 11;
+            index[JSON_FLOAT]   = 12;
+        }
+    };
+    constexpr TokenIndexTable   tokenIndexTable;
+
+    inline int tokenIndex(int token)
+    {
+        return (token >= 0 && token < TokenIndexTable::size) ? tokenIndexTable.index[token] : 0;
+    }
+
+    // The Fast lexer hands back the input it read ahead by seeking.
+    // On a stream that can not seek that input would be lost so use flex.
+    JsonParser::LexerType streamLexer(std::istream& stream, JsonParser::LexerType lexerType)
+    {
+        if (lexerType == JsonParser::LexerType::Fast && stream.tellg() == std::streampos(-1))
+        {
+            return JsonParser::LexerType::Flex;
+        }
+        return lexerType;
+    }
+}
+
+JsonParser::JsonParser(std::istream& stream, ParseType parseStrictness, LexerType lexerType)
     : ParserInterface(stream, parseStrictness)
+    , lexerType(streamLexer(stream, lexerType))
     , lexer(&stream)
+    , fastLexer(&stream)
     , currentEnd(Done)
     , currentState(Init)
     , started(false)
 {}
 
+JsonParser::JsonParser(std::string_view data, ParseType parseStrictness)
+    : ParserInterface(parseStrictness)
+    , lexerType(LexerType::Fast)
+    , lexer(&input)
+    , fastLexer(data)
+    , currentEnd(Done)
+    , currentState(Init)
+    , started(false)
+{}
+
+JsonParser::JsonParser(char const* data, std::size_t size, ParseType parseStrictness)
+    : JsonParser(std::string_view(data, size), parseStrictness)
+{}
+
+void JsonParser::reset(std::string_view data)
+{
+    lexerType       = LexerType::Fast;
+    fastLexer.reset(data);
+    parrentState.clear();
+    currentEnd      = Done;
+    currentState    = Init;
+    started         = false;
+    pushBack        = ParserToken::Error;
+}
+
+// State transition table;
+JsonParser::State const JsonParser::stateTable[][13]   =
+{
+    /* Token   ->   0,      1,      2,      3,      4,      5,      6,      7,      8,      9,      10,     11,     12 */
+    /* Error */ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* Init  */ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueD, ValueD, ValueD, ValueD, ValueD, ValueD  },
+    /* OpenM */ {   Error,  Error,  CloseM, Error,  Error,  Error,  Error,  Error,  Error,  Error,  Key,    Error,  Error   },
+    /* Key   */ {   Error,  Error,  Error,  Error,  Error,  Error,  Colon,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* Colon */ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueM, ValueM, ValueM, ValueM, ValueM, ValueM  },
+    /* ValueM*/ {   Error,  Error,  CloseM, Error,  Error,  CommaM, Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* CommaM*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Key,    Error,  Error   },
+    /* CloseM*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* OpenA */ {   Error,  OpenM,  Error,  OpenA,  CloseA, Error,  Error,  ValueA, ValueA, ValueA, ValueA, ValueA, ValueA  },
+    /* ValueA*/ {   Error,  Error,  Error,  Error,  CloseA, CommaA, Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* CommaA*/ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueA, ValueA, ValueA, ValueA, ValueA, ValueA  },
+    /* CloseA*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* ValueD*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+    /* Done  */ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
+};
+
 ParserToken JsonParser::getNextToken()
 {
     /* Handle States were we are not going to read any more */
@@ -27,6 +119,7 @@ ParserToken JsonParser::getNextToken()
     }
     if (currentState == Done)
     {
+        lexRelease();
         currentState = Error;
         return ParserToken::DocEnd;
     }
@@ -35,111 +128,136 @@ ParserToken JsonParser::getNextToken()
         return ParserToken::Error;
     }
 
-    // Convert Lexer tokens into smaller range 0-12
-    static std::map<int, int>   tokenIndex  =
-    {
-        {0,                                     0},
-        {'{',                                   1},
-        {'}',                                   2},
-        {'[',                                   3},
-        {']',                                   4},
-        {',',                                   5},
-        {':',                                   6},
-        {ThorsAnvil::Serialize::JSON_TRUE,      7},
-        {ThorsAnvil::Serialize::JSON_FALSE,     8},
-        {ThorsAnvil::Serialize::JSON_NULL,      9},
-        {ThorsAnvil::Serialize::JSON_STRING,    10},
-        {ThorsAnvil::Serialize::JSON_INTEGER,   11},
-        {ThorsAnvil::Serialize::JSON_FLOAT,     12}
-    };
-    // State transition table;
-    static State   stateTable[][13]   =
-    {
-        /* Token   ->   0,      1,      2,      3,      4,      5,      6,      7,      8,      9,      10,     11,     12 */
-        /* Error */ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* Init  */ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueD, ValueD, ValueD, ValueD, ValueD, ValueD  },
-        /* OpenM */ {   Error,  Error,  CloseM, Error,  Error,  Error,  Error,  Error,  Error,  Error,  Key,    Error,  Error   },
-        /* Key   */ {   Error,  Error,  Error,  Error,  Error,  Error,  Colon,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* Colon */ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueM, ValueM, ValueM, ValueM, ValueM, ValueM  },
-        /* ValueM*/ {   Error,  Error,  CloseM, Error,  Error,  CommaM, Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* CommaM*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Key,    Error,  Error   },
-        /* CloseM*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* OpenA */ {   Error,  OpenM,  Error,  OpenA,  CloseA, Error,  Error,  ValueA, ValueA, ValueA, ValueA, ValueA, ValueA  },
-        /* ValueA*/ {   Error,  Error,  Error,  Error,  CloseA, CommaA, Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* CommaA*/ {   Error,  OpenM,  Error,  OpenA,  Error,  Error,  Error,  ValueA, ValueA, ValueA, ValueA, ValueA, ValueA  },
-        /* CloseA*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* ValueD*/ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-        /* Done  */ {   Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error,  Error   },
-    };
+    // Punctuation (Colon/Comma) is consumed by looping rather than recursing.
+    for (;;)
+    {
+        // Read the next token and update the state.
+        currentState    = stateTable[currentState][tokenIndex(lexToken())];
+        switch (currentState)
+        {
+            // These states should be impossible to get too
+            case Init:      throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Got into Init State");
+            case Done:      throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Got into Done State");
+            // The states that we actually want to return
+            case Error:     lexRelease(); return ParserToken::Error;
+            case Key:       return ParserToken::Key;
+            case ValueM:    return ParserToken::Value;
+            case ValueA:    return ParserToken::Value;
+            case ValueD:    currentState = Done; return ParserToken::Value;
+            // Punctuation.
+            // Parse it but it is not the actual result
+            // So try and get the next token.
+            case Colon:     continue;
+            case CommaM:    continue;
+            case CommaA:    continue;
+            // We are going into a containing object.
 
-    // Read the next token and update the state.
-    int token   = lexer.yylex();
-    int index   = tokenIndex[token];
+            // Push the state we want when the containing
+            // object is complete then set the state we will
+            // need if we open another container.
+            case OpenM:
+                parrentState.push_back(currentEnd);
+                currentEnd  = ValueM;
+                return ParserToken::MapStart;
+            case OpenA:
+                parrentState.push_back(currentEnd);
+                currentEnd  = ValueA;
+                return ParserToken::ArrayStart;
 
-    currentState    = stateTable[currentState][index];
-    switch (currentState)
-    {
-        // These states should be impossible to get too
-        case Init:      throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Got into Init State");
-        case Done:      throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Got into Done State");
-        // The states that we actually want to return
-        case Error:     return ParserToken::Error;
-        case Key:       return ParserToken::Key;
-        case ValueM:    return ParserToken::Value;
-        case ValueA:    return ParserToken::Value;
-        case ValueD:    currentState = Done; return ParserToken::Value;
-        // Punctuation.
-        // Parse it but it is not the actual result
-        // So try and get the next token.
-        case Colon:     return getNextToken();
-        case CommaM:    return getNextToken();
-        case CommaA:    return getNextToken();
-        // We are going into a containing object.
-
-        // Push the state we want when the containing
-        // object is complete then set the state we will
-        // need if we open another container.
-        case OpenM:
-            parrentState.push_back(currentEnd);
-            currentEnd  = ValueM;
-            return ParserToken::MapStart;
-        case OpenA:
-            parrentState.push_back(currentEnd);
-            currentEnd  = ValueA;
-            return ParserToken::ArrayStart;
-
-        // We are leaving the containing object.
-        // Pop the state we previously saved.
-        case CloseM:
-            currentEnd  = currentState    = parrentState.back();
-            parrentState.pop_back();
-            return ParserToken::MapEnd;
-        case CloseA:
-            currentEnd  = currentState    = parrentState.back();
-            parrentState.pop_back();
-            return ParserToken::ArrayEnd;
-
-        // Anything else just break.
-        default:
-            break;
+            // We are leaving the containing object.
+            // Pop the state we previously saved.
+            case CloseM:
+                currentEnd  = currentState    = parrentState.back();
+                parrentState.pop_back();
+                return ParserToken::MapEnd;
+            case CloseA:
+                currentEnd  = currentState    = parrentState.back();
+                parrentState.pop_back();
+                return ParserToken::ArrayEnd;
+
+            // Anything else just break.
+            default:
+                break;
+        }
+        break;
     }
     // If we hit anything else there was a serious problem in the
     // parser itself.
     throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Reached an Unnamed State");
 }
 
-std::string JsonParser::getString()
+/*
+ * If the string has no escape characters the result is a view directly into
+ * the lexer buffer. Otherwise it is decoded into `unescaped` (which is reused).
+ * Either way the view is only valid until the next token is read.
+ */
+std::string_view JsonParser::getString()
 {
-    if (lexer.YYLeng() < 2 || lexer.YYText()[0] != '"' || lexer.YYText()[lexer.YYLeng()-1] != '"')
+    if (lexLength() < 2 || lexText()[0] != '"' || lexText()[lexLength()-1] != '"')
     {
         throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Not a String value");
     }
     // Remember to drop the quotes
-    return std::string(make_UnicodeWrapperIterator(lexer.YYText() + 1),
-                       make_UnicodeWrapperIterator(lexer.YYText() + lexer.YYLeng() - 1));
+    char const* begin   = lexText() + 1;
+    char const* end     = lexText() + lexLength() - 1;
+    if (std::memchr(begin, '\\', end - begin) == nullptr)
+    {
+        return std::string_view(begin, end - begin);
+    }
+    unescaped.assign(make_UnicodeWrapperIterator(begin), make_UnicodeWrapperIterator(end));
+    return unescaped;
+}
+
+/*
+ * The Fast lexer can skip the raw input.
+ * The parser state is moved on as if a single value token had been read.
+ */
+void JsonParser::skipValue()
+{
+    if (lexerType != LexerType::Fast || pushBack != ParserToken::Error || !started || currentState == Done || currentState == Error)
+    {
+        ParserInterface::skipValue();
+        return;
+    }
+    // Consume the ':' after a key or the ',' after an earlier array value.
+    if (currentState == Key || currentState == ValueA)
+    {
+        currentState = stateTable[currentState][tokenIndex(lexToken())];
+    }
+    currentState = stateTable[currentState][tokenIndex(JSON_STRING)];
+    switch (currentState)
+    {
+        case ValueM:    break;
+        case ValueA:    break;
+        case ValueD:    currentState = Done; break;
+        default:
+            lexRelease();
+            currentState = Error;
+            throw std::runtime_error("ThorsAnvil::Serialize::JsonParser::skipValue: Invalid position to skip a value");
+    }
+    fastLexer.skipValue();
+}
+
+std::size_t JsonParser::getSizeHint()
+{
+    if (lexerType != LexerType::Fast || pushBack != ParserToken::Error || (currentState != OpenM && currentState != OpenA))
+    {
+        return 0;
+    }
+    return fastLexer.countValues(sizeHintLimit);
 }
 
 std::string JsonParser::getKey()
+{
+    return std::string(getString());
+}
+
+std::string_view JsonParser::getKeyView()
+{
+    return getString();
+}
+
+std::string_view JsonParser::getValueView()
 {
     return getString();
 }
@@ -147,9 +265,8 @@ std::string JsonParser::getKey()
 template<typename T>
 inline T JsonParser::scan()
 {
-    char*   end;
-    T value = scanValue<T>(lexer.YYText(), &end);
-    if (lexer.YYText() + lexer.YYLeng() != end)
+    T value;
+    if (!scanValue(lexText(), lexText() + lexLength(), value))
     {
         throw std::runtime_error("ThorsAnvil::Serialize::JsonParser: Not an integer");
     }
@@ -172,11 +289,11 @@ void JsonParser::getValue(long double& value)                   {value = scan<lo
 
 void JsonParser::getValue(bool& value)
 {
-    if (lexer.YYLeng() == 4 && std::strncmp(lexer.YYText(), "true", 4) == 0)
+    if (lexLength() == 4 && std::strncmp(lexText(), "true", 4) == 0)
     {
         value = true;
     }
-    else if (lexer.YYLeng() == 5 && std::strncmp(lexer.YYText(), "false", 5) == 0)
+    else if (lexLength() == 5 && std::strncmp(lexText(), "false", 5) == 0)
     {
         value = false;
     }
@@ -188,5 +305,23 @@ void JsonParser::getValue(bool& value)
 
 void JsonParser::getValue(std::string& value)
 {
-    value = getString();
+    value.assign(getString());
 }
+
+bool JsonParser::tryGetValue(short& value)                   {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(int& value)                     {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(long& value)                    {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(long long& value)               {return tryGetValueWith(*this, value);}
+
+bool JsonParser::tryGetValue(unsigned short& value)          {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(unsigned int& value)            {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(unsigned long& value)           {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(unsigned long long& value)      {return tryGetValueWith(*this, value);}
+
+bool JsonParser::tryGetValue(float& value)                   {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(double& value)                  {return tryGetValueWith(*this, value);}
+bool JsonParser::tryGetValue(long double& value)             {return tryGetValueWith(*this, value);}
+
+bool JsonParser::tryGetValue(bool& value)                    {return tryGetValueWith(*this, value);}
+
+bool JsonParser::tryGetValue(std::string& value)             {return tryGetValueWith(*this, value);}
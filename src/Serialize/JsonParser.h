@@ -15,12 +15,35 @@
  *      For Objects the order of elements is not important. It looks up the key in the Traits<T>
  *      information to understand which member is being de-serialized but unspecified elements
  *      will not cause an error.
+ *
+ *      Two lexer backends are available:
+ *          LexerType::Flex     The flex generated lexer (see JsonLexer.l)
+ *          LexerType::Fast     The SIMD assisted hand written lexer (see JsonFastLexer.h)
+ *      Both generate the same tokens and drive the same state table. The default is
+ *      selected at build time (configure --enable-json-fast-lexer) but can be overridden
+ *      at runtime by passing the lexer type to the constructor.
+ *      The Fast lexer reads ahead so it is only used on streams that can seek (it hands
+ *      back the unused input by seeking). Other streams (pipes, sockets, a terminal)
+ *      always use the Flex lexer so nothing past the end of the document is consumed.
+ *
+ *      The parser can also be constructed directly on a contiguous block of memory
+ *      (pointer and size or std::string_view). This always uses LexerType::Fast and
+ *      scans the memory in place; the memory must outlive the parser.
+ *      reset() switches the parser to a new block of memory so a single parser can
+ *      be used for a sequence of documents (see JsonLinesImporter.h).
+ *
+ *      With the Fast lexer getSizeHint() counts the values of a map/array that has
+ *      just been opened if it closes within the next sizeHintLimit bytes already
+ *      in memory (the flex lexer does not give access to its buffer).
  */
 
+#include "SerializeConfig.h"
 #include "Serialize.h"
 #include "JsonLexer.h"
+#include "JsonFastLexer.h"
 #include <istream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ThorsAnvil
@@ -28,24 +51,55 @@ namespace ThorsAnvil
     namespace Serialize
     {
 
-class JsonParser: public ParserInterface
+class JsonParser final: public ParserInterface
 {
+    public:
+        enum class LexerType {Flex, Fast};
+#ifdef JSON_FAST_LEXER
+        static constexpr LexerType defaultLexer = LexerType::Fast;
+#else
+        static constexpr LexerType defaultLexer = LexerType::Flex;
+#endif
+    private:
     enum State          {Error, Init, OpenM, Key, Colon, ValueM, CommaM, CloseM, OpenA, ValueA, CommaA, CloseA, ValueD, Done};
+    static State const  stateTable[][13];
 
+    LexerType           lexerType;
     JsonLexerFlexLexer  lexer;
+    JsonFastLexer       fastLexer;
     std::vector<State>  parrentState;
     State               currentEnd;
     State               currentState;
     bool                started;
+    std::string         unescaped;
+
+    int         lexToken()          {return lexerType == LexerType::Fast ? fastLexer.yylex()  : lexer.yylex();}
+    char const* lexText() const     {return lexerType == LexerType::Fast ? fastLexer.YYText() : lexer.YYText();}
+    int         lexLength() const   {return lexerType == LexerType::Fast ? fastLexer.YYLeng() : lexer.YYLeng();}
+    void        lexRelease()        {if (lexerType == LexerType::Fast) {fastLexer.release();}}
 
-    std::string getString();
+    std::string_view getString();
 
     template<typename T>
     T scan();
     public:
-        JsonParser(std::istream& stream, ParseType parseStrictness = ParseType::Weak);
+        static constexpr std::size_t sizeHintLimit = 16 * 1024;
+
+        JsonParser(std::istream& stream, ParseType parseStrictness = ParseType::Weak, LexerType lexerType = defaultLexer);
+        JsonParser(std::string_view data, ParseType parseStrictness = ParseType::Weak);
+        JsonParser(char const* data, std::size_t size, ParseType parseStrictness = ParseType::Weak);
+        // Parse a new document held in memory.
+        // The parser (and its buffers) can be reused for many small documents.
+        void                reset(std::string_view data);
+        // When parsing memory: the point just after the last token read.
+        char const*         position() const                    {return fastLexer.position();}
+
         virtual ParserToken getNextToken()                      override;
         virtual std::string getKey()                            override;
+        virtual void        skipValue()                         override;
+        virtual std::size_t getSizeHint()                       override;
+        virtual std::string_view getKeyView()                   override;
+        virtual std::string_view getValueView()                 override;
 
         virtual void    getValue(short int& value)              override;
         virtual void    getValue(int& value)                    override;
@@ -64,6 +118,25 @@ class JsonParser: public ParserInterface
         virtual void    getValue(bool& value)                   override;
 
         virtual void    getValue(std::string& value)            override;
+
+        using ParserInterface::tryGetValue;
+        virtual bool    tryGetValue(short int& value)               override;
+        virtual bool    tryGetValue(int& value)                     override;
+        virtual bool    tryGetValue(long int& value)                override;
+        virtual bool    tryGetValue(long long int& value)           override;
+
+        virtual bool    tryGetValue(unsigned short int& value)      override;
+        virtual bool    tryGetValue(unsigned int& value)            override;
+        virtual bool    tryGetValue(unsigned long int& value)       override;
+        virtual bool    tryGetValue(unsigned long long int& value)  override;
+
+        virtual bool    tryGetValue(float& value)                   override;
+        virtual bool    tryGetValue(double& value)                  override;
+        virtual bool    tryGetValue(long double& value)             override;
+
+        virtual bool    tryGetValue(bool& value)                    override;
+
+        virtual bool    tryGetValue(std::string& value)             override;
 };
     }
 }
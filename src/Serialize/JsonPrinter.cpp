@@ -20,7 +20,7 @@ namespace
                 , size(size)
                 , state(state)
             {}
-            void printSeporator(std::ostream& stream, bool key) const
+            void printSeporator(JsonOutputBuffer& stream, bool key) const
             {
                 char const*(&seporator)[] = (!key && state.second == TraitType::Map)
                                             ? colon
@@ -31,20 +31,21 @@ namespace
     struct PrefixKey: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixKey const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixKey const& data)
         {
             data.printSeporator(stream, true);
             if (data.characteristics == PrinterInterface::OutputType::Stream)
             {
                 return stream;
             }
-            return stream << "\n" << std::string(data.size, '\t');
+            stream.writeIndent(data.size);
+            return stream;
         }
     };
     struct PrefixValue: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixValue const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixValue const& data)
         {
             data.printSeporator(stream, false);
             ++data.state.first;
@@ -59,7 +60,7 @@ namespace
     struct PrefixMap: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixMap const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixMap const& data)
         {
             data.printSeporator(stream, false);
 
@@ -67,26 +68,28 @@ namespace
             {
                 return stream;
             }
-            return stream << "\n" << std::string(data.size, '\t');
+            stream.writeIndent(data.size);
+            return stream;
         }
     };
     struct PrefixMapClose: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixMapClose const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixMapClose const& data)
         {
             ++data.state.first;
             if (data.characteristics == PrinterInterface::OutputType::Stream)
             {
                 return stream;
             }
-            return stream << "\n" << std::string(data.size, '\t');
+            stream.writeIndent(data.size);
+            return stream;
         }
     };
     struct PrefixArray: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixArray const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixArray const& data)
         {
             data.printSeporator(stream, false);
             return stream;
@@ -95,12 +98,27 @@ namespace
     struct PrefixArrayClose: public Prefix
     {
         using Prefix::Prefix;
-        friend std::ostream& operator<<(std::ostream& stream, PrefixArrayClose const& data)
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, PrefixArrayClose const& data)
         {
             ++data.state.first;
             return stream;
         }
     };
+    template<typename T>
+    struct Number
+    {
+        T   value;
+        friend JsonOutputBuffer& operator<<(JsonOutputBuffer& stream, Number const& data)
+        {
+            stream.writeNumber(data.value);
+            return stream;
+        }
+    };
+    template<typename T>
+    Number<T> number(T value)
+    {
+        return Number<T>{value};
+    }
 }
 
 char const*  Prefix::space[]   = {" ",  "",  " "};
@@ -109,6 +127,7 @@ char const*  Prefix::colon[]   = {": ", ":", ": "};
 
 JsonPrinter::JsonPrinter(std::ostream& output, OutputType characteristics)
     : PrinterInterface(output, characteristics)
+    , buffer(output)
 {
     state.emplace_back(0, TraitType::Value);
 }
@@ -116,11 +135,22 @@ JsonPrinter::JsonPrinter(std::ostream& output, OutputType characteristics)
 void JsonPrinter::openDoc()
 {}
 void JsonPrinter::closeDoc()
-{}
+{
+    buffer.flush();
+}
+
+// When the top level value is complete make it visible on the stream.
+void JsonPrinter::endValue()
+{
+    if (state.size() == 1)
+    {
+        buffer.flush();
+    }
+}
 
 void JsonPrinter::openMap()
 {
-    output << PrefixMap(characteristics, state.size(), state.back()) << "{";
+    buffer << PrefixMap(characteristics, state.size(), state.back()) << "{";
     state.emplace_back(0, TraitType::Map);
 }
 void JsonPrinter::closeMap()
@@ -130,13 +160,18 @@ void JsonPrinter::closeMap()
         throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to closeMap(): Currently not in a map");
     }
     state.pop_back();
-    output << PrefixMapClose(characteristics, state.size(), state.back()) << "}";
+    buffer << PrefixMapClose(characteristics, state.size(), state.back()) << "}";
+    endValue();
 }
 void JsonPrinter::openArray(std::size_t)
 {
-    output << PrefixArray(characteristics, state.size(), state.back()) << "[";
+    buffer << PrefixArray(characteristics, state.size(), state.back()) << "[";
     state.emplace_back(0, TraitType::Array);
 }
+void JsonPrinter::resumeArray(std::size_t count)
+{
+    state.emplace_back(static_cast<int>(count != 0), TraitType::Array);
+}
 void JsonPrinter::closeArray()
 {
     if (state.back().second != TraitType::Array)
@@ -144,7 +179,8 @@ void JsonPrinter::closeArray()
         throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to closeArray(): Currently not in an array");
     }
     state.pop_back();
-    output << PrefixArrayClose(characteristics, state.size(), state.back()) << "]";
+    buffer << PrefixArrayClose(characteristics, state.size(), state.back()) << "]";
+    endValue();
 }
 
 void JsonPrinter::addKey(std::string const& key)
@@ -153,22 +189,40 @@ void JsonPrinter::addKey(std::string const& key)
     {
         throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to addKey(): Currently not in a map");
     }
-    output << PrefixKey(characteristics, state.size(), state.back()) << '"' << key << '"';
+    buffer << PrefixKey(characteristics, state.size(), state.back()) << '"' << key << '"';
+}
+void JsonPrinter::addKey(MemberKey const& key)
+{
+    if (state.back().second != TraitType::Map)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::JsonPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    buffer << PrefixKey(characteristics, state.size(), state.back());
+    if (key.quoted != nullptr)
+    {
+        buffer.write(key.quoted, key.size + 2);
+    }
+    else
+    {
+        buffer << '"';
+        buffer.write(key.name, key.size);
+        buffer << '"';
+    }
 }
 
-void JsonPrinter::addValue(short value)                 {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(int value)                   {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(long value)                  {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(long long value)             {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
+void JsonPrinter::addValue(short value)                 {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(int value)                   {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(long value)                  {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(long long value)             {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
 
-void JsonPrinter::addValue(unsigned short value)        {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(unsigned int value)          {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(unsigned long value)         {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(unsigned long long value)    {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
+void JsonPrinter::addValue(unsigned short value)        {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(unsigned int value)          {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(unsigned long value)         {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(unsigned long long value)    {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
 
-void JsonPrinter::addValue(float value)                 {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(double value)                {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
-void JsonPrinter::addValue(long double value)           {output << PrefixValue(characteristics, state.size(), state.back()) << value;}
+void JsonPrinter::addValue(float value)                 {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(double value)                {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
+void JsonPrinter::addValue(long double value)           {buffer << PrefixValue(characteristics, state.size(), state.back()) << number(value); endValue();}
 
-void JsonPrinter::addValue(bool value)                  {output << PrefixValue(characteristics, state.size(), state.back()) << std::boolalpha << value;}
-void JsonPrinter::addValue(std::string const& value)    {output << PrefixValue(characteristics, state.size(), state.back()) << '"' << value << '"';}
+void JsonPrinter::addValue(bool value)                  {buffer << PrefixValue(characteristics, state.size(), state.back()) << (value ? "true" : "false"); endValue();}
+void JsonPrinter::addValue(std::string const& value)    {buffer << PrefixValue(characteristics, state.size(), state.back()) << '"' << value << '"'; endValue();}
@@ -3,19 +3,116 @@
 /*
  * JsonaryPrinter<T>
  *  See documentation in JsonParser.h
+ *
+ *  The printer does not use the stream formatting (operator<<) for each token.
+ *  All output is built in a JsonOutputBuffer (a contiguous block of memory) that
+ *  is written to the stream in large blocks and when the top level value is complete.
  */
 
 #include "Serialize.h"
+#include <string>
 #include <vector>
+#include <memory>
+#include <cstring>
 
 namespace ThorsAnvil
 {
     namespace Serialize
     {
 
-class JsonPrinter: public PrinterInterface
+class JsonOutputBuffer
+{
+    public:
+        static constexpr std::size_t    BlockSize   = 64 * 1024;
+    private:
+        std::ostream&               output;
+        std::unique_ptr<char[]>     buffer;     // Allocated on first use and not zero filled.
+        std::size_t                 used;
+        std::string                 tabs;
+
+        void makeSpace(std::size_t size)
+        {
+            if (!buffer)
+            {
+                buffer.reset(new char[BlockSize]);
+            }
+            else if (BlockSize - used < size)
+            {
+                flush();
+            }
+        }
+    public:
+        JsonOutputBuffer(std::ostream& output)
+            : output(output)
+            , used(0)
+        {}
+        ~JsonOutputBuffer()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+                // Destructors must not throw (the stream may have exceptions enabled).
+                // Call flush() directly to see errors.
+            }
+        }
+        void flush()
+        {
+            if (used != 0)
+            {
+                output.write(buffer.get(), used);
+                used = 0;
+            }
+        }
+        void write(char const* data, std::size_t size)
+        {
+            if (size > BlockSize)
+            {
+                flush();
+                output.write(data, size);
+                return;
+            }
+            makeSpace(size);
+            std::memcpy(buffer.get() + used, data, size);
+            used += size;
+        }
+        void write(char value)
+        {
+            makeSpace(1);
+            buffer[used++] = value;
+        }
+        template<typename T>
+        void writeNumber(T value)
+        {
+            makeSpace(printValueBufferSize);
+            char*   start   = buffer.get() + used;
+            used += printValue(start, start + printValueBufferSize, value) - start;
+        }
+        // New line followed by `size` tabs.
+        // The tabs are kept so they are not rebuilt for each line.
+        void writeIndent(std::size_t size)
+        {
+            if (tabs.size() < size)
+            {
+                tabs.resize(size, '\t');
+            }
+            write('\n');
+            write(tabs.data(), size);
+        }
+
+        JsonOutputBuffer& operator<<(char value)                  {write(value);return *this;}
+        JsonOutputBuffer& operator<<(char const* value)           {write(value, std::strlen(value));return *this;}
+        JsonOutputBuffer& operator<<(std::string const& value)    {write(value.data(), value.size());return *this;}
+};
+
+class JsonPrinter final: public PrinterInterface
 {
     std::vector<std::pair<int, TraitType>> state;
+    JsonOutputBuffer                       buffer;
+
+    void endValue();
     public:
         JsonPrinter(std::ostream& output, OutputType characteristics = OutputType::Default);
         virtual void openDoc()                              override;
@@ -26,7 +123,10 @@ class JsonPrinter: public PrinterInterface
         virtual void openArray(std::size_t size)            override;
         virtual void closeArray()                           override;
 
+        using PrinterInterface::addKey;
+        using PrinterInterface::addValue;
         virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
 
         virtual void addValue(short int value)              override;
         virtual void addValue(int value)                    override;
@@ -45,6 +145,12 @@ class JsonPrinter: public PrinterInterface
         virtual void addValue(bool value)                   override;
 
         virtual void addValue(std::string const& value)     override;
+
+        // Write anything buffered to the stream.
+        void flush()                                        {buffer.flush();}
+        // Continue an array that has already been opened (and may already
+        // have `count` elements) without printing the '[' (see JsonArrayWriter.h).
+        void resumeArray(std::size_t count);
 };
 
     }
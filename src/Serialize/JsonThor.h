@@ -9,12 +9,32 @@
  * Usage:
  *      std::cout << jsonExport(object); // converts object to Json on an output stream
  *      std::cin  >> jsonImport(object); // converts Json to a C++ object from an input stream
+ *
+ *      jsonImport(text, object);         // converts Json held in memory (std::string_view or
+ *      jsonImport(data, size, object);   // pointer/size) to a C++ object without copying it into a stream
+ *      jsonImportFile(path, object);     // converts Json in a file (memory mapped) to a C++ object
+ *
+ *      std::cin  >> jsonReparse(object); // same as jsonImport() but the object is reset first
+ *      jsonReparse(text, object);        // (keeping the memory of its strings and containers)
+ *
+ *      std::cin  >> jsonImport(object, resource);   // the std::pmr strings and containers in object
+ *      jsonImport(text, object, resource);           // allocate from resource (a std::pmr::memory_resource*)
+ *
+ *      for (auto& object: jsonLinesImport<T>(stream))  // reads one object per line (NDJSON)
+ *      jsonForEach<T>(stream, action);   // calls action(T&&) for each element of a top level array
+ *                                        // (both can reuse the memory of the object, see reparse)
  */
 
 #include "JsonParser.h"
 #include "JsonPrinter.h"
 #include "Exporter.h"
 #include "Importer.h"
+#include "JsonLinesImporter.h"
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <utility>
 
 namespace ThorsAnvil
 {
@@ -36,6 +56,66 @@ template<typename T>
 Importer<Json, T> jsonImport(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
 {
     return Importer<Json, T>(value, parseStrictness);
+}
+template<typename T>
+void jsonImport(std::string_view input, T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    JsonParser      parser(input, parseStrictness);
+    BasicDeSerializer<JsonParser>   deSerializer(parser);
+
+    deSerializer.parse(value);
+}
+template<typename T>
+Importer<Json, T> jsonImport(T& value, std::pmr::memory_resource* resource, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    return Importer<Json, T>(value, parseStrictness, false, resource);
+}
+template<typename T>
+void jsonImport(std::string_view input, T& value, std::pmr::memory_resource* resource, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    JsonParser      parser(input, parseStrictness);
+    BasicDeSerializer<JsonParser>   deSerializer(parser, resource);
+
+    deSerializer.parse(value);
+}
+template<typename T>
+void jsonImport(char const* input, std::size_t size, T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    jsonImport(std::string_view(input, size), value, parseStrictness);
+}
+template<typename T>
+Importer<Json, T> jsonReparse(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    return Importer<Json, T>(value, parseStrictness, true);
+}
+template<typename T>
+void jsonReparse(std::string_view input, T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    resetObject(value);
+    jsonImport(input, value, parseStrictness);
+}
+template<typename T>
+void jsonImportFile(std::string const& path, T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    MappedFile      file(path);
+    jsonImport(file.data(), value, parseStrictness);
+}
+template<typename T, typename F>
+void jsonForEach(std::istream& stream, F&& action, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak, bool reparse = false)
+{
+    JsonParser      parser(stream, parseStrictness);
+    parseEachElement<T>(parser, std::forward<F>(action), reparse);
+}
+template<typename T, typename F>
+void jsonForEach(std::string_view input, F&& action, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak, bool reparse = false)
+{
+    JsonParser      parser(input, parseStrictness);
+    parseEachElement<T>(parser, std::forward<F>(action), reparse);
+}
+template<typename T>
+JsonLinesImporter<T> jsonLinesImport(std::istream& stream, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak, typename JsonLinesImporter<T>::BadLine badLine = JsonLinesImporter<T>::BadLine::Throw, bool reparse = false)
+{
+    return JsonLinesImporter<T>(stream, parseStrictness, badLine, reparse);
 }
     }
 }
@@ -0,0 +1,49 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace ThorsAnvil::Serialize;
+
+MappedFile::MappedFile(std::string const& path)
+    : mapping(nullptr)
+    , size(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::MappedFile::MappedFile: Failed to open file: " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == -1)
+    {
+        ::close(fd);
+        throw std::runtime_error("ThorsAnvil::Serialize::MappedFile::MappedFile: Failed to stat file: " + path);
+    }
+
+    size = info.st_size;
+    // mmap() can not map zero bytes. An empty file is simply empty data.
+    if (size != 0)
+    {
+        mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("ThorsAnvil::Serialize::MappedFile::MappedFile: Failed to map file: " + path);
+        }
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+    }
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (size != 0)
+    {
+        ::munmap(mapping, size);
+    }
+}
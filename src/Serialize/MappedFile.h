@@ -0,0 +1,58 @@
+#ifndef THORS_ANVIL_SERIALIZE_MAPPED_FILE_H
+#define THORS_ANVIL_SERIALIZE_MAPPED_FILE_H
+/*
+ * MappedFile
+ *      Maps a whole file read-only into memory (mmap) so the parsers can work
+ *      directly on the file content rather than copying it through an ifstream.
+ *      The mapping is advised as MADV_SEQUENTIAL as the parsers read front to back.
+ *
+ *      The content is available as a std::string_view via data() and stays valid
+ *      for the lifetime of the MappedFile.
+ *
+ * MemoryStreamBuf
+ *      A read only stream buffer over a block of memory. The get area is the
+ *      memory itself, so a std::istream using it reads without an intermediate
+ *      buffer copy. Used for parsers that only know how to read from a stream.
+ *
+ * Usage:
+ *      MappedFile          file("data.json");
+ *      jsonImport(file.data(), object);
+ */
+
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+class MappedFile
+{
+    void*           mapping;
+    std::size_t     size;
+    public:
+        MappedFile(std::string const& path);
+        ~MappedFile();
+        MappedFile(MappedFile const&)               = delete;
+        MappedFile& operator=(MappedFile const&)    = delete;
+
+        std::string_view data() const   {return std::string_view(static_cast<char const*>(mapping), size);}
+};
+
+class MemoryStreamBuf: public std::streambuf
+{
+    public:
+        MemoryStreamBuf(std::string_view data)
+        {
+            char* begin = const_cast<char*>(data.data());
+            setg(begin, begin, begin + data.size());
+        }
+};
+
+    }
+}
+
+#endif
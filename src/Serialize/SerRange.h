@@ -0,0 +1,181 @@
+#ifndef THORS_ANVIL_SERIALIZE_SER_RANGE_H
+#define THORS_ANVIL_SERIALIZE_SER_RANGE_H
+/*
+ * Print a sequence of values as an array without first putting them in a container.
+ *
+ *      std::cout << jsonExport(serializeRange(begin, end));
+ *      std::cout << jsonExport(serializeRange(begin, end, size));
+ *      std::cout << jsonExport(serializeGenerator<V>(generator));
+ *      std::cout << jsonExport(serializeGenerator<V>(generator, size));
+ *
+ *  SerializeRange<I>
+ *      Any pair of input iterators (e.g. a database cursor or std::istream_iterator).
+ *  SerializeGenerator<V, G>
+ *      A callable object that returns std::optional<V>. It is called until it returns an empty optional.
+ *
+ *  Both are output only and can only be printed once (the input is consumed).
+ *
+ *  The size:
+ *      Json and Yaml do not need to know the number of elements up front.
+ *      Binary writes the size before the elements. If the size is not given (and can not be
+ *      calculated from forward iterators) the array is opened with unknownArraySize and the
+ *      BinaryPrinter goes back and fills in the size once it is known (the stream must be seekable).
+ *      If a size is given it must be correct.
+ *
+ *      The Binary hash is the same as std::vector<V> so the data can be read back into a vector.
+ */
+
+#include "Traits.h"
+#include "Serialize.h"
+#include "SerUtil.h"
+#include "BinaryTHash.h"
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+
+template<typename I>
+class SerializeRange
+{
+    I               first;
+    I               last;
+    std::size_t     sizeHint;
+    public:
+        using value_type = typename std::decay<typename std::iterator_traits<I>::value_type>::type;
+
+        SerializeRange(I first, I last, std::size_t sizeHint)
+            : first(std::move(first))
+            , last(std::move(last))
+            , sizeHint(sizeHint)
+        {}
+        std::size_t size() const    {return sizeHint;}
+
+        template<typename F>
+        void forEach(F&& action) const
+        {
+            for (I loop = first; loop != last; ++loop)
+            {
+                action(*loop);
+            }
+        }
+};
+
+template<typename V, typename G>
+class SerializeGenerator
+{
+    G mutable       generator;
+    std::size_t     sizeHint;
+    public:
+        using value_type = V;
+
+        SerializeGenerator(G generator, std::size_t sizeHint)
+            : generator(std::move(generator))
+            , sizeHint(sizeHint)
+        {}
+        std::size_t size() const    {return sizeHint;}
+
+        template<typename F>
+        void forEach(F&& action) const
+        {
+            for (std::optional<V> value = generator(); value; value = generator())
+            {
+                action(*value);
+            }
+        }
+};
+
+template<typename I>
+SerializeRange<I> serializeRange(I first, I last, std::size_t size)
+{
+    return SerializeRange<I>(std::move(first), std::move(last), size);
+}
+template<typename I>
+SerializeRange<I> serializeRange(I first, I last)
+{
+    using Category = typename std::iterator_traits<I>::iterator_category;
+    std::size_t size = PrinterInterface::unknownArraySize;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+    {
+        size = std::distance(first, last);
+    }
+    return SerializeRange<I>(std::move(first), std::move(last), size);
+}
+template<typename V, typename G>
+SerializeGenerator<V, G> serializeGenerator(G generator, std::size_t size = PrinterInterface::unknownArraySize)
+{
+    return SerializeGenerator<V, G>(std::move(generator), size);
+}
+
+/* ------------------------------- RangeMemberExtractor ------------------------------- */
+/*
+ * Same as ContainerMemberExtractor (see SerUtil.h) but only for printing.
+ */
+template<typename R, typename V = typename R::value_type>
+class RangeMemberExtractor
+{
+    public:
+        constexpr RangeMemberExtractor() {}
+        constexpr std::size_t getHash(std::size_t start) const
+        {
+            return thash<std::vector<V>>(start);
+        }
+        template<typename Printer>
+        void operator()(Printer& printer, R const& object) const
+        {
+            PutValueType<V, Printer>    valuePutter(printer);
+            std::size_t         count = 0;
+            object.forEach([&valuePutter, &count](V const& value)
+            {
+                valuePutter.putValue(value);
+                ++count;
+            });
+
+            if (object.size() == PrinterInterface::unknownArraySize)
+            {
+                printer.arraySize(count);
+            }
+            else if (object.size() != count)
+            {   throw std::runtime_error("ThorsAnvil::Serialize::RangeMemberExtractor: Number of values printed does not match the size given");
+            }
+        }
+};
+
+/* ------------------------------- Traits<SerializeRange<I>> ------------------------------- */
+template<typename I>
+class Traits<SerializeRange<I>>
+{
+    public:
+        static constexpr TraitType type = TraitType::Array;
+        typedef RangeMemberExtractor<SerializeRange<I>>     MemberExtractor;
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+
+/* ------------------------------- Traits<SerializeGenerator<V, G>> ------------------------------- */
+template<typename V, typename G>
+class Traits<SerializeGenerator<V, G>>
+{
+    public:
+        static constexpr TraitType type = TraitType::Array;
+        typedef RangeMemberExtractor<SerializeGenerator<V, G>>  MemberExtractor;
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+
+    }
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "Serialize.h"
 #include "BinaryTHash.h"
 #include <utility>
+#include <algorithm>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -15,6 +16,7 @@
 #include <list>
 #include <array>
 #include <tuple>
+#include <type_traits>
 #include <initializer_list>
 
 /*
@@ -45,6 +47,8 @@
  *      Traits<std::unordered_multimap<std::string,V>>
  * Traits<std::initializer_list<T>>
  *
+ * The std::pmr containers are these templates with a std::pmr::polymorphic_allocator
+ * so they use the same Traits (string keys can be std::pmr::string).
  */
 
 namespace ThorsAnvil
@@ -62,9 +66,10 @@ template<typename V, TraitType type = Traits<V>::type>
 class GetValueType
 {
     public:
-        GetValueType(ParserInterface& parser, V& value)
+        template<typename Parser>
+        GetValueType(Parser& parser, V& value)
         {
-            DeSerializer            deSerializer(parser, false);
+            BasicDeSerializer<Parser>   deSerializer(parser, false);
             deSerializer.parse(value);
         }
 };
@@ -73,12 +78,12 @@ template<typename V>
 class GetValueType<V, TraitType::Value>
 {
     public:
-        GetValueType(ParserInterface& parser, V& value)
+        template<typename Parser>
+        GetValueType(Parser& parser, V& value)
         {
-            if (parser.getToken() != ThorsAnvil::Serialize::ParserInterface::ParserToken::Value)
+            if (!parser.tryGetValue(value))
             {   throw std::runtime_error("ThorsAnvil::Serializer::SerMap::GetValueType::GetValueType<Value>: Expecting a normal value after the key");
             }
-            parser.getValue(value);
         }
 };
 
@@ -88,12 +93,12 @@ class GetValueType<V, TraitType::Value>
  * A normal value is put directly onto the stream (via the printer object).
  * A compound type Map/Array is printed to the stream using a Serializer.
  */
-template<typename V, TraitType type = Traits<V>::type>
+template<typename V, typename Printer = PrinterInterface, TraitType type = Traits<V>::type>
 class PutValueType
 {
-    Serializer      serializer;
+    BasicSerializer<Printer>    serializer;
     public:
-        PutValueType(PrinterInterface& printer)
+        PutValueType(Printer& printer)
             : serializer(printer, false)
         {}
         void putValue(V const& value)
@@ -102,12 +107,12 @@ class PutValueType
         }
 };
 
-template<typename V>
-class PutValueType<V, TraitType::Value>
+template<typename V, typename Printer>
+class PutValueType<V, Printer, TraitType::Value>
 {
-    PrinterInterface&   printer;
+    Printer&            printer;
     public:
-        PutValueType(PrinterInterface& printer)
+        PutValueType(Printer& printer)
             : printer(printer)
         {}
 
@@ -119,12 +124,25 @@ class PutValueType<V, TraitType::Value>
 
 /* ------------------------------- MemberInserter ------------------------------- */
 /*
- * Defines how a value is inserted into a container.
+ * Defines how a value is read from the parser into a container.
  * Overloaded for each container type (no generic definition)
+ *
+ * Where the container allows it the element is created first and the value is
+ * parsed directly into it. Containers that order by value (sets and the maps
+ * represented as arrays of pairs) need the whole value before it can be placed,
+ * so these parse into a local that is then moved into the container.
+ *
+ * Containers that can make use of the parsers size hint (see ParserInterface::getSizeHint())
+ * also define reserve(parser). It is called once after the array/map is opened.
  */
 template<typename T>
 class MemberInserter;
 
+template<typename C, typename Parser, typename = void>
+struct MemberInserterReserves: std::false_type {};
+template<typename C, typename Parser>
+struct MemberInserterReserves<C, Parser, std::void_t<decltype(std::declval<MemberInserter<C>&>().reserve(std::declval<Parser&>()))>>: std::true_type {};
+
 /* ------------------------------- ContainerMemberExtractor ------------------------------- */
 /*
  * A generic contain manipulator class
@@ -138,9 +156,13 @@ class MemberInserter;
  * but recursively use the DeSerializer class for Map/Array types.
  *
  * Note each container has differences in the insert technique thus we use a MemberInserter
- * object to do the inserting of values after they have been read. The class attempts to do this
- * using move semantics.
+ * object to read each value into the container.
  */
+template<typename C, typename = void>
+struct ContainerHasClear: std::false_type {};
+template<typename C>
+struct ContainerHasClear<C, std::void_t<decltype(std::declval<C&>().clear())>>: std::true_type {};
+
 template<typename C, typename V = typename C::value_type>
 class ContainerMemberExtractor
 {
@@ -150,21 +172,45 @@ class ContainerMemberExtractor
         {
             return thash<C>(start);
         }
-        void operator()(PrinterInterface& printer, C const& object) const
+        template<typename Printer>
+        void operator()(Printer& printer, C const& object) const
         {
-            PutValueType<V>     valuePutter(printer);
+            PutValueType<V, Printer>    valuePutter(printer);
             for (auto const& loop: object)
             {
                 valuePutter.putValue(loop);
             }
         }
-        void operator()(ParserInterface& parser, std::size_t const& index, C& object) const
+        template<typename Parser>
+        void operator()(Parser& parser, std::size_t const& index, C& object) const
         {
-            V                   data;
-            GetValueType<V>     valueGetter(parser, data);
-
             MemberInserter<C>   inserter(object);
-            inserter.add(index, std::move(data));
+            inserter.add(parser, index);
+        }
+        template<typename Parser>
+        void reserve(Parser& parser, C& object) const
+        {
+            if constexpr (MemberInserterReserves<C, Parser>::value)
+            {
+                MemberInserter<C>   inserter(object);
+                inserter.reserve(parser);
+            }
+        }
+        // See resetObject(): containers are cleared (keeping their capacity).
+        // Fixed size containers (std::array) reset each element instead.
+        void reset(C& object) const
+        {
+            if constexpr (ContainerHasClear<C>::value)
+            {
+                object.clear();
+            }
+            else if constexpr (!std::is_const<std::remove_reference_t<decltype(*std::begin(object))>>::value)
+            {
+                for (auto& value: object)
+                {
+                    resetObject(value);
+                }
+            }
         }
 };
 
@@ -194,9 +240,13 @@ class MemberInserter<std::initializer_list<T>>
         MemberInserter(std::initializer_list<T>& container)
             : container(container)
         {}
-        void add(std::size_t const& , T&& )
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
             //static_assert(false, "Can not de-serialize and initializer list");
+            // The value is read (so the parser stays in step) and dropped.
+            T                   value;
+            GetValueType<T>     valueGetter(parser, value);
         }
 };
 
@@ -222,9 +272,11 @@ class MemberInserter<std::array<T, N>>
         MemberInserter(std::array<T, N>& container)
             : container(container)
         {}
-        void add(std::size_t const& index, T&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const& index)
         {
-            container[index] = std::forward<T>(value);
+            useParserMemory(parser, container[index]);
+            GetValueType<T>     valueGetter(parser, container[index]);
         }
 };
 
@@ -250,9 +302,12 @@ class MemberInserter<std::list<T, Allocator>>
         MemberInserter(std::list<T, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, T&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.push_back(std::forward<T>(value));
+            container.emplace_back();
+            useParserMemory(parser, container.back());
+            GetValueType<T>     valueGetter(parser, container.back());
         }
 };
 
@@ -278,9 +333,32 @@ class MemberInserter<std::vector<T, Allocator>>
         MemberInserter(std::vector<T, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, T&& value)
+        template<typename Parser>
+        void reserve(Parser& parser)
+        {
+            std::size_t needed = container.size() + parser.getSizeHint();
+            if (needed > container.capacity())
+            {
+                // Never less than double so repeatedly appending to a vector stays amortized.
+                container.reserve(std::max(needed, container.capacity() * 2));
+            }
+        }
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.push_back(std::forward<T>(value));
+            // std::vector<bool> has no bool& to parse into.
+            if constexpr (std::is_same<typename std::vector<T, Allocator>::reference, T&>::value)
+            {
+                container.emplace_back();
+                useParserMemory(parser, container.back());
+                GetValueType<T>     valueGetter(parser, container.back());
+            }
+            else
+            {
+                T                   value;
+                GetValueType<T>     valueGetter(parser, value);
+                container.push_back(std::move(value));
+            }
         }
 };
 
@@ -306,9 +384,12 @@ class MemberInserter<std::deque<T, Allocator>>
         MemberInserter(std::deque<T, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, T&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.push_back(std::forward<T>(value));
+            container.emplace_back();
+            useParserMemory(parser, container.back());
+            GetValueType<T>     valueGetter(parser, container.back());
         }
 };
 
@@ -334,9 +415,13 @@ class MemberInserter<std::set<Key, Compare, Allocator>>
         MemberInserter(std::set<Key, Compare, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, Key&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.insert(std::forward<Key>(value));
+            Key                 value;
+            useParserMemory(parser, value);
+            GetValueType<Key>   valueGetter(parser, value);
+            container.insert(std::move(value));
         }
 };
 
@@ -362,9 +447,22 @@ class MemberInserter<std::unordered_set<Key, Hash, KeyEqual, Allocator>>
         MemberInserter(std::unordered_set<Key, Hash, KeyEqual, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, Key&& value)
+        template<typename Parser>
+        void reserve(Parser& parser)
         {
-            container.insert(std::forward<Key>(value));
+            std::size_t hint = parser.getSizeHint();
+            if (hint != 0)
+            {
+                container.reserve(container.size() + hint);
+            }
+        }
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
+        {
+            Key                 value;
+            useParserMemory(parser, value);
+            GetValueType<Key>   valueGetter(parser, value);
+            container.insert(std::move(value));
         }
 };
 
@@ -390,9 +488,13 @@ class MemberInserter<std::multiset<Key, Compare, Allocator>>
         MemberInserter(std::multiset<Key, Compare, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, Key&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.insert(std::forward<Key>(value));
+            Key                 value;
+            useParserMemory(parser, value);
+            GetValueType<Key>   valueGetter(parser, value);
+            container.insert(std::move(value));
         }
 };
 
@@ -418,9 +520,22 @@ class MemberInserter<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>>
         MemberInserter(std::unordered_multiset<Key, Hash, KeyEqual, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, Key&& value)
+        template<typename Parser>
+        void reserve(Parser& parser)
         {
-            container.insert(std::forward<Key>(value));
+            std::size_t hint = parser.getSizeHint();
+            if (hint != 0)
+            {
+                container.reserve(container.size() + hint);
+            }
+        }
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
+        {
+            Key                 value;
+            useParserMemory(parser, value);
+            GetValueType<Key>   valueGetter(parser, value);
+            container.insert(std::move(value));
         }
 };
 
@@ -437,6 +552,25 @@ class Traits<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>>
         }
 };
 
+/* ------------------------------- makeStringKey ------------------------------- */
+/*
+ * Build the key of a string keyed map from the view returned by the parser.
+ * If the key can use the map's allocator it does, so the keys of a std::pmr map
+ * come from the same memory resource as its nodes.
+ */
+template<typename Key, typename Allocator>
+Key makeStringKey(std::string_view const& key, Allocator const& allocator)
+{
+    if constexpr (std::is_constructible<typename Key::allocator_type, Allocator const&>::value)
+    {
+        return Key(key.data(), key.size(), typename Key::allocator_type(allocator));
+    }
+    else
+    {
+        return Key(key.data(), key.size());
+    }
+}
+
 /* ------------------------------- Traits<std::map<Key, Value>> ------------------------------- */
 template<typename Key,typename T, typename Compare, typename Allocator>
 class MemberInserter<std::map<Key, T, Compare, Allocator>>
@@ -446,9 +580,13 @@ class MemberInserter<std::map<Key, T, Compare, Allocator>>
         MemberInserter(std::map<Key, T, Compare, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, std::pair<Key, T>&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            std::pair<Key, T>               value;
+            useParserMemory(parser, value);
+            GetValueType<std::pair<Key, T>> valueGetter(parser, value);
+            container.emplace(std::move(value.first), std::move(value.second));
         }
 };
 
@@ -466,12 +604,14 @@ class Traits<std::map<Key, T, Compare, Allocator>>
 };
 
 /*
- * std::map<> we use a specialization when the key is a std::string.
+ * std::map<> we use a specialization when the key is a string (std::string or std::pmr::string).
  * This allows maps that have string keys to be represented directly by Json Map objects.
  */
-template<typename Value>
-class Traits<std::map<std::string, Value>>
+template<typename CharTraits, typename KeyAllocator, typename Value, typename Allocator>
+class Traits<std::map<std::basic_string<char, CharTraits, KeyAllocator>, Value, std::less<std::basic_string<char, CharTraits, KeyAllocator>>, Allocator>>
 {
+    using Key       = std::basic_string<char, CharTraits, KeyAllocator>;
+    using Container = std::map<Key, Value, std::less<Key>, Allocator>;
     public:
         static constexpr TraitType type = TraitType::Map;
 
@@ -479,20 +619,35 @@ class Traits<std::map<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::map<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, Container const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Printer>    valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::map<std::string, Value>& object) const
+                void reset(Container& object) const
                 {
-                    Value                   data;
-                    GetValueType<Value>     valueGetter(parser, data);
-                    object.insert(std::make_pair(std::move(key), std::move(data)));
+                    object.clear();
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string_view const& key, Container& object) const
+                {
+                    // key is a view into the parser buffer: the node owns its copy before the value is read.
+                    // The value is then parsed directly into the node.
+                    auto inserted = object.try_emplace(makeStringKey<Key>(key, object.get_allocator()));
+                    if (!inserted.second)
+                    {
+                        // Repeated key: the first value is kept (as insert() did).
+                        Value                   ignore;
+                        GetValueType<Value>     valueGetter(parser, ignore);
+                        return;
+                    }
+                    useParserMemory(parser, inserted.first->second);
+                    GetValueType<Value>     valueGetter(parser, inserted.first->second);
                 }
         };
 
@@ -512,9 +667,22 @@ class MemberInserter<std::unordered_map<Key, T, Hash, KeyEqual, Allocator>>
         MemberInserter(std::unordered_map<Key, T, Hash, KeyEqual, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, std::pair<Key, T>&& value)
+        template<typename Parser>
+        void reserve(Parser& parser)
+        {
+            std::size_t hint = parser.getSizeHint();
+            if (hint != 0)
+            {
+                container.reserve(container.size() + hint);
+            }
+        }
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            std::pair<Key, T>               value;
+            useParserMemory(parser, value);
+            GetValueType<std::pair<Key, T>> valueGetter(parser, value);
+            container.emplace(std::move(value.first), std::move(value.second));
         }
 };
 
@@ -532,12 +700,14 @@ class Traits<std::unordered_map<Key, T, Hash, KeyEqual, Allocator>>
 };
 
 /*
- * std::unordered_map<> we use a specialization when the key is a std::string.
+ * std::unordered_map<> we use a specialization when the key is a string (std::string or std::pmr::string).
  * This allows unordered_maps that have string keys to be represented directly by Json Map objects.
  */
-template<typename Value>
-class Traits<std::unordered_map<std::string, Value>>
+template<typename CharTraits, typename KeyAllocator, typename Value, typename Allocator>
+class Traits<std::unordered_map<std::basic_string<char, CharTraits, KeyAllocator>, Value, std::hash<std::basic_string<char, CharTraits, KeyAllocator>>, std::equal_to<std::basic_string<char, CharTraits, KeyAllocator>>, Allocator>>
 {
+    using Key       = std::basic_string<char, CharTraits, KeyAllocator>;
+    using Container = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, Allocator>;
     public:
         static constexpr TraitType type = TraitType::Map;
 
@@ -545,20 +715,44 @@ class Traits<std::unordered_map<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::unordered_map<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, Container const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Printer>    valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::unordered_map<std::string, Value>& object) const
+                template<typename Parser>
+                void reserve(Parser& parser, Container& object) const
+                {
+                    std::size_t hint = parser.getSizeHint();
+                    if (hint != 0)
+                    {
+                        object.reserve(object.size() + hint);
+                    }
+                }
+                void reset(Container& object) const
                 {
-                    Value                   data;
-                    GetValueType<Value>     valueGetter(parser, data);
-                    object.insert(std::make_pair(std::move(key), std::move(data)));
+                    object.clear();
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string_view const& key, Container& object) const
+                {
+                    // key is a view into the parser buffer: the node owns its copy before the value is read.
+                    // The value is then parsed directly into the node.
+                    auto inserted = object.try_emplace(makeStringKey<Key>(key, object.get_allocator()));
+                    if (!inserted.second)
+                    {
+                        // Repeated key: the first value is kept (as insert() did).
+                        Value                   ignore;
+                        GetValueType<Value>     valueGetter(parser, ignore);
+                        return;
+                    }
+                    useParserMemory(parser, inserted.first->second);
+                    GetValueType<Value>     valueGetter(parser, inserted.first->second);
                 }
         };
 
@@ -578,9 +772,22 @@ class MemberInserter<std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>>
         MemberInserter(std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, std::pair<Key, T>&& value)
+        template<typename Parser>
+        void reserve(Parser& parser)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            std::size_t hint = parser.getSizeHint();
+            if (hint != 0)
+            {
+                container.reserve(container.size() + hint);
+            }
+        }
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
+        {
+            std::pair<Key, T>               value;
+            useParserMemory(parser, value);
+            GetValueType<std::pair<Key, T>> valueGetter(parser, value);
+            container.emplace(std::move(value.first), std::move(value.second));
         }
 };
 
@@ -597,9 +804,11 @@ class Traits<std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>>
         }
 };
 
-template<typename Value>
-class Traits<std::unordered_multimap<std::string, Value>>
+template<typename CharTraits, typename KeyAllocator, typename Value, typename Allocator>
+class Traits<std::unordered_multimap<std::basic_string<char, CharTraits, KeyAllocator>, Value, std::hash<std::basic_string<char, CharTraits, KeyAllocator>>, std::equal_to<std::basic_string<char, CharTraits, KeyAllocator>>, Allocator>>
 {
+    using Key       = std::basic_string<char, CharTraits, KeyAllocator>;
+    using Container = std::unordered_multimap<Key, Value, std::hash<Key>, std::equal_to<Key>, Allocator>;
     public:
         static constexpr TraitType type = TraitType::Map;
 
@@ -607,20 +816,37 @@ class Traits<std::unordered_multimap<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::unordered_multimap<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, Container const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Printer>    valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::unordered_multimap<std::string, Value>& object) const
+                template<typename Parser>
+                void reserve(Parser& parser, Container& object) const
+                {
+                    std::size_t hint = parser.getSizeHint();
+                    if (hint != 0)
+                    {
+                        object.reserve(object.size() + hint);
+                    }
+                }
+                void reset(Container& object) const
+                {
+                    object.clear();
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string_view const& key, Container& object) const
                 {
-                    Value                   data;
-                    GetValueType<Value>     valueGetter(parser, data);
-                    object.insert(std::make_pair(std::move(key), std::move(data)));
+                    // key is a view into the parser buffer: the node owns its copy before the value is read.
+                    // The value is then parsed directly into the node.
+                    auto inserted = object.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+                    useParserMemory(parser, inserted->second);
+                    GetValueType<Value>     valueGetter(parser, inserted->second);
                 }
         };
 
@@ -640,9 +866,13 @@ class MemberInserter<std::multimap<Key, T, Compare, Allocator>>
         MemberInserter(std::multimap<Key, T, Compare, Allocator>& container)
             : container(container)
         {}
-        void add(std::size_t const&, std::pair<Key, T>&& value)
+        template<typename Parser>
+        void add(Parser& parser, std::size_t const&)
         {
-            container.insert(std::forward<std::pair<Key, T>>(value));
+            std::pair<Key, T>               value;
+            useParserMemory(parser, value);
+            GetValueType<std::pair<Key, T>> valueGetter(parser, value);
+            container.emplace(std::move(value.first), std::move(value.second));
         }
 };
 
@@ -659,9 +889,11 @@ class Traits<std::multimap<Key, T, Compare, Allocator>>
         }
 };
 
-template<typename Value>
-class Traits<std::multimap<std::string, Value>>
+template<typename CharTraits, typename KeyAllocator, typename Value, typename Allocator>
+class Traits<std::multimap<std::basic_string<char, CharTraits, KeyAllocator>, Value, std::less<std::basic_string<char, CharTraits, KeyAllocator>>, Allocator>>
 {
+    using Key       = std::basic_string<char, CharTraits, KeyAllocator>;
+    using Container = std::multimap<Key, Value, std::less<Key>, Allocator>;
     public:
         static constexpr TraitType type = TraitType::Map;
 
@@ -669,20 +901,28 @@ class Traits<std::multimap<std::string, Value>>
         {
             public:
                 constexpr MemberExtractor(){}
-                void operator()(PrinterInterface& printer, std::multimap<std::string, Value> const& object) const
+                template<typename Printer>
+                void operator()(Printer& printer, Container const& object) const
                 {
-                    PutValueType<Value>     valuePutter(printer);
+                    PutValueType<Value, Printer>    valuePutter(printer);
                     for (auto const& loop: object)
                     {
                         printer.addKey(loop.first);
                         valuePutter.putValue(loop.second);
                     }
                 }
-                void operator()(ParserInterface& parser, std::string const& key, std::multimap<std::string, Value>& object) const
+                void reset(Container& object) const
                 {
-                    Value                   data;
-                    GetValueType<Value>     valueGetter(parser, data);
-                    object.insert(std::make_pair(std::move(key), std::move(data)));
+                    object.clear();
+                }
+                template<typename Parser>
+                void operator()(Parser& parser, std::string_view const& key, Container& object) const
+                {
+                    // key is a view into the parser buffer: the node owns its copy before the value is read.
+                    // The value is then parsed directly into the node.
+                    auto inserted = object.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+                    useParserMemory(parser, inserted->second);
+                    GetValueType<Value>     valueGetter(parser, inserted->second);
                 }
         };
 
@@ -716,29 +956,29 @@ class ContainerTuppleExtractor
 {
         using C = std::tuple<Args...>;
 
-        template<std::size_t index, typename V>
-        void printTupleValue(PrinterInterface& printer, C const& object) const
+        template<std::size_t index, typename V, typename Printer>
+        void printTupleValue(Printer& printer, C const& object) const
         {
-            PutValueType<V>     valuePutter(printer);
+            PutValueType<V, Printer>    valuePutter(printer);
             valuePutter.putValue(std::get<index>(object));
         }
-        template<std::size_t... index>
-        void printTupleValues(PrinterInterface& printer, C const& object, std::index_sequence<index...> const&) const
+        template<typename Printer, std::size_t... index>
+        void printTupleValues(Printer& printer, C const& object, std::index_sequence<index...> const&) const
         {
             auto discard = {(printTupleValue<index, typename std::tuple_element_t<index, C>>(printer, object),1)...};
             (void)discard;
         }
-        template<std::size_t index, typename V>
-        void parseTupleValue(ParserInterface& parser, C& object) const
+        template<std::size_t index, typename V, typename Parser>
+        void parseTupleValue(Parser& parser, C& object) const
         {
             V&                  data(std::get<index>(object));
             GetValueType<V>     valueGetter(parser, data);
         }
-        template<std::size_t... index>
-        void parseTupleValues(ParserInterface& parser, std::size_t const& id, C& object,  std::index_sequence<index...> const&) const
+        template<typename Parser, std::size_t... index>
+        void parseTupleValues(Parser& parser, std::size_t const& id, C& object,  std::index_sequence<index...> const&) const
         {
-            using MemberDecoder = decltype(&ContainerTuppleExtractor::parseTupleValue<0, typename std::tuple_element_t<0, C>>);
-            static std::initializer_list<MemberDecoder> parseTuppleValue = {&ContainerTuppleExtractor::parseTupleValue<index, typename std::tuple_element_t<index, C>>...};
+            using MemberDecoder = decltype(&ContainerTuppleExtractor::parseTupleValue<0, typename std::tuple_element_t<0, C>, Parser>);
+            static std::initializer_list<MemberDecoder> parseTuppleValue = {&ContainerTuppleExtractor::parseTupleValue<index, typename std::tuple_element_t<index, C>, Parser>...};
             auto iteratorToFunction = parseTuppleValue.begin() + id;
             auto function = *iteratorToFunction;
             (this->*function)(parser, object);
@@ -749,14 +989,20 @@ class ContainerTuppleExtractor
         {
             return thash<int>(start);
         }
-        void operator()(PrinterInterface& printer, C const& object) const
+        template<typename Printer>
+        void operator()(Printer& printer, C const& object) const
         {
             printTupleValues(printer, object, std::make_index_sequence<sizeof...(Args)>());
         }
-        void operator()(ParserInterface& parser, std::size_t const& index, C& object) const
+        template<typename Parser>
+        void operator()(Parser& parser, std::size_t const& index, C& object) const
         {
             parseTupleValues(parser, index, object, std::make_index_sequence<sizeof...(Args)>());
         }
+        void reset(C& object) const
+        {
+            std::apply([](auto&... value){auto discard = {0, (resetObject(value),1)...}; (void)discard;}, object);
+        }
 };
 
 /*
@@ -2,12 +2,23 @@
 
 using ThorsAnvil::Serialize::ParserInterface;
 
+std::istream& ParserInterface::noInput()
+{
+    static std::istream noStream(nullptr);
+    return noStream;
+}
+
 void ParserInterface::ignoreValue()
 {
     if (parseStrictness == ParseType::Strict)
     {   throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreValue: In Strict parser mode not allowed to ignore values.");
     }
 
+    skipValue();
+}
+
+void ParserInterface::skipValue()
+{
     ignoreTheValue();
 }
 
@@ -15,7 +26,6 @@ void ParserInterface::ignoreTheMap()
 {
     for (ParserToken token = getNextToken(); token != ParserToken::MapEnd; token = getNextToken())
     {
-        std::cout << "Ignoring Next Map Item\n";
         if (token != ParserToken::Key)
         {   throw std::runtime_error("ThorsAnvil::Serialize::ParserInterface::ignoreTheMap: Invalid token found. (Expecting Key)");
         }
@@ -71,6 +81,10 @@ void ParserInterface::ignoreTheValue()
 #include "test/SerializeTest.h"
 #include "test/BinaryParserTest.h"
 #include "test/IgnoreUneededData.h"
+#include "SerRange.h"
+#include <functional>
+#include <iterator>
+#include <optional>
 
 
 template void ThorsAnvil::Serialize::Serializer::print<Base>(Base const&);
@@ -115,6 +129,12 @@ template void ThorsAnvil::Serialize::DeSerializer::parse<std::map<int, double>>(
 template void ThorsAnvil::Serialize::DeSerializer::parse<std::multimap<int, double>>(std::multimap<int, double>&);
 template void ThorsAnvil::Serialize::DeSerializer::parse<std::map<std::string, bool>>(std::map<std::string, bool>&);
 template void ThorsAnvil::Serialize::DeSerializer::parse<std::multimap<std::string, bool>>(std::multimap<std::string, bool>&);
+template void ThorsAnvil::Serialize::DeSerializer::parse<std::vector<std::vector<int>>>(std::vector<std::vector<int>>&);
+template void ThorsAnvil::Serialize::DeSerializer::parse<std::vector<std::map<std::string, bool>>>(std::vector<std::map<std::string, bool>>&);
+
+template void ThorsAnvil::Serialize::Serializer::print<ThorsAnvil::Serialize::SerializeRange<std::vector<int>::const_iterator>>(ThorsAnvil::Serialize::SerializeRange<std::vector<int>::const_iterator> const&);
+template void ThorsAnvil::Serialize::Serializer::print<ThorsAnvil::Serialize::SerializeRange<std::istream_iterator<int>>>(ThorsAnvil::Serialize::SerializeRange<std::istream_iterator<int>> const&);
+template void ThorsAnvil::Serialize::Serializer::print<ThorsAnvil::Serialize::SerializeGenerator<int, std::function<std::optional<int>()>>>(ThorsAnvil::Serialize::SerializeGenerator<int, std::function<std::optional<int>()>> const&);
 
 template void ThorsAnvil::Serialize::Serializer::print<RGB>(RGB const&);
 template void ThorsAnvil::Serialize::DeSerializer::parse<RGB>(RGB&);
@@ -27,6 +27,11 @@
  *                                                                          of the object. Deserializer ask the parser for a
  *                                                                          sequence of events from the input stream and converts
  *                                                                          these into updates on the object.
+ *      BasicSerializer<Printer>            BasicDeSerializer<Parser>       Serializer/DeSerializer are these templates with the
+ *                                                                          Printer/Parser as PrinterInterface/ParserInterface.
+ *                                                                          If the concrete (final) Printer/Parser type is used
+ *                                                                          the calls for each value are not virtual and can be
+ *                                                                          inlined (Exporter.h/Importer.h do this).
  *      SerializeMember                     DeSerializeMember               Generated (at compile time) from the Traits<T> information
  *                                                                          for each member that needs to be printed/parsed
  */
@@ -34,6 +39,17 @@
 #include "Traits.h"
 #include <iostream>
 #include <utility>
+#include <charconv>
+#include <system_error>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <memory_resource>
+#include <exception>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdio>
+#include <limits>
 
 namespace ThorsAnvil
 {
@@ -48,15 +64,31 @@ class ParserInterface
         std::istream&   input;
         ParserToken     pushBack;
         ParseType       parseStrictness;
+        // If set the objects built while parsing allocate from this resource (see useMemoryResource()).
+        std::pmr::memory_resource*  memoryResource;
 
         ParserInterface(std::istream& input, ParseType parseStrictness = ParseType::Weak)
             : input(input)
             , pushBack(ParserToken::Error)
             , parseStrictness(parseStrictness)
+            , memoryResource(nullptr)
+        {}
+        // For parsers that read directly from memory (not a stream).
+        // input refers to an empty stream that has no buffer.
+        ParserInterface(ParseType parseStrictness = ParseType::Weak)
+            : input(noInput())
+            , pushBack(ParserToken::Error)
+            , parseStrictness(parseStrictness)
+            , memoryResource(nullptr)
         {}
         virtual ~ParserInterface() {}
-                ParserToken     getToken();
+        static  std::istream&   noInput();
+                ParserToken     getToken()              {return nextToken(*this);}
                 void            pushBackToken(ParserToken token);
+        // Same as getToken() but when called with a concrete (final) parser type
+        // the call to getNextToken() is not virtual.
+        template<typename Parser>
+        static  ParserToken     nextToken(Parser& parser);
         virtual ParserToken     getNextToken()          = 0;
         virtual std::string     getKey()                = 0;
 
@@ -78,8 +110,53 @@ class ParserInterface
 
         virtual void    getValue(std::string&)           = 0;
 
+        // Read the next token and if it is a Value decode it into value.
+        // This is a single call rather than getToken() followed by getValue().
+        // If the token is not a Value it is pushed back and false is returned.
+        virtual bool    tryGetValue(short int& value)               {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(int& value)                     {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long int& value)                {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long long int& value)           {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(unsigned short int& value)      {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned int& value)            {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned long int& value)       {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(unsigned long long int& value)  {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(float& value)                   {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(double& value)                  {return tryGetValueWith(*this, value);}
+        virtual bool    tryGetValue(long double& value)             {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(bool& value)                    {return tryGetValueWith(*this, value);}
+
+        virtual bool    tryGetValue(std::string& value)             {return tryGetValueWith(*this, value);}
+        // Strings that use another allocator (std::pmr::string) are copied from getValueView().
+        template<typename CharTraits, typename Allocator>
+        bool            tryGetValue(std::basic_string<char, CharTraits, Allocator>& value);
+
+        // Same as getKey()/getValue(std::string&) but without building a new string.
+        // The view is only valid until the next token is read.
+        // Parsers override these to return a view directly into their input buffer.
+        virtual std::string_view getKeyView()           {viewBuffer = getKey(); return viewBuffer;}
+        virtual std::string_view getValueView()         {getValue(viewBuffer);  return viewBuffer;}
+
         void    ignoreValue();
+        // Skip the next value (and everything inside it if it is a map or array).
+        // The default walks the tokens; parsers override this to skip the raw input.
+        virtual void    skipValue();
+        // Only valid directly after a MapStart or ArrayStart token.
+        // The number of values in the map/array if the parser can tell cheaply, otherwise 0.
+        // It is only used to reserve space in containers; it is not checked.
+        // As it may come from untrusted input parsers must keep it bounded.
+        virtual std::size_t getSizeHint()               {return 0;}
+    protected:
+        // Implementation of tryGetValue().
+        // Parsers call this with their own (final) type so the calls are not virtual.
+        template<typename Parser, typename T>
+        static bool     tryGetValueWith(Parser& parser, T& value);
     private:
+        std::string     viewBuffer;
+
         void    ignoreTheValue();
         void    ignoreTheMap();
         void    ignoreTheArray();
@@ -93,6 +170,10 @@ class PrinterInterface
         // Stream:      Compressed for over the wire protocol.
         // Config:      Human readable (potentially config file like)
 
+        // Passed to openArray() when the number of elements is not known in advance
+        // (see SerRange.h). Printers that need the size are told it by arraySize().
+        static constexpr std::size_t unknownArraySize = static_cast<std::size_t>(-1);
+
         std::ostream&   output;
         OutputType      characteristics;
 
@@ -107,8 +188,13 @@ class PrinterInterface
         virtual void closeMap()                         = 0;
         virtual void openArray(std::size_t size)        = 0;
         virtual void closeArray()                       = 0;
+        // Called just before closeArray() for arrays opened with unknownArraySize.
+        virtual void arraySize(std::size_t)             {}
 
         virtual void    addKey(std::string const& key)  = 0;
+        // Keys for members of user types (see Traits.h).
+        // Printers override this to avoid building a std::string for each key.
+        virtual void    addKey(MemberKey const& key)    {addKey(std::string(key.name, key.size));}
 
         virtual void    addValue(short int)             = 0;
         virtual void    addValue(int)                   = 0;
@@ -128,90 +214,185 @@ class PrinterInterface
 
         virtual void    addValue(std::string const&)    = 0;
 
+        // Strings that use another allocator (std::pmr::string).
+        template<typename CharTraits, typename Allocator>
+        void    addKey(std::basic_string<char, CharTraits, Allocator> const& key)      {addKey(std::string(key.data(), key.size()));}
+        template<typename CharTraits, typename Allocator>
+        void    addValue(std::basic_string<char, CharTraits, Allocator> const& value)  {addValue(std::string(value.data(), value.size()));}
+
         void addValue(void*)        = delete;
         void addValue(void const*)  = delete;
 };
 
+/*
+ * Convert the text [begin, end) into a number of type T.
+ * Returns true only if all the text is a valid number that fits into T.
+ *
+ * Uses std::from_chars() so the result does not depend on the current locale
+ * and the text does not need to be null terminated. A leading '+' is accepted
+ * (valid in Yaml; the Json lexer never generates it).
+ *
+ * If the standard library does not provide floating point from_chars() the
+ * floating point versions fall back to the C conversion functions.
+ */
+template<typename T>
+inline bool scanValue(char const* begin, char const* end, T& value)
+{
+    if (end - begin > 1 && begin[0] == '+' && begin[1] != '-')
+    {
+        ++begin;
+    }
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+#ifndef __cpp_lib_to_chars
 template<typename T>
-T scanValue(char const* buffer, char** end);
+inline bool scanFloatValue(char const* begin, char const* end, T& value, T (*convert)(char const*, char**))
+{
+    std::string     text(begin, end);
+    char*           last;
+    errno   = 0;
+    value   = convert(text.c_str(), &last);
+    return !text.empty() && last == text.c_str() + text.size() && errno != ERANGE;
+}
+template<>  inline bool scanValue<float>(char const* begin, char const* end, float& value)              {return scanFloatValue(begin, end, value, &std::strtof);}
+template<>  inline bool scanValue<double>(char const* begin, char const* end, double& value)            {return scanFloatValue(begin, end, value, &std::strtod);}
+template<>  inline bool scanValue<long double>(char const* begin, char const* end, long double& value)  {return scanFloatValue(begin, end, value, &std::strtold);}
+#endif
+
+/*
+ * Convert a number of type T into text written to [begin, end).
+ * Returns the end of the text. A buffer of printValueBufferSize is always big enough.
+ *
+ * Uses std::to_chars(): integers are converted two digits at a time and floating
+ * point values are written with the shortest text that reads back as exactly the
+ * same value. It does not depend on the current locale.
+ *
+ * If the standard library does not provide floating point to_chars() the floating
+ * point versions fall back to snprintf() with enough digits to round-trip.
+ */
+static constexpr std::size_t printValueBufferSize = 64;
 
-template<>  inline short                   scanValue<short>(char const* buffer, char** end)                   {return std::strtol(buffer, end, 10);}
-template<>  inline int                     scanValue<int>(char const* buffer, char** end)                     {return std::strtol(buffer, end, 10);}
-template<>  inline long int                scanValue<long int>(char const* buffer, char** end)                {return std::strtol(buffer, end, 10);}
-template<>  inline long long int           scanValue<long long int>(char const* buffer, char** end)           {return std::strtoll(buffer, end, 10);}
+template<typename T>
+inline char* printValue(char* begin, char* end, T value)
+{
+    return std::to_chars(begin, end, value).ptr;
+}
 
-template<>  inline unsigned short          scanValue<unsigned short>(char const* buffer, char** end)          {return std::strtoul(buffer, end, 10);}
-template<>  inline unsigned int            scanValue<unsigned int>(char const* buffer, char** end)            {return std::strtoul(buffer, end, 10);}
-template<>  inline unsigned long int       scanValue<unsigned long int>(char const* buffer, char** end)       {return std::strtoul(buffer, end, 10);}
-template<>  inline unsigned long long int  scanValue<unsigned long long int>(char const* buffer, char** end)  {return std::strtoull(buffer, end, 10);}
+#ifndef __cpp_lib_to_chars
+template<>  inline char* printValue<float>(char* begin, char* end, float value)              {return begin + std::snprintf(begin, end - begin, "%.*g", std::numeric_limits<float>::max_digits10, value);}
+template<>  inline char* printValue<double>(char* begin, char* end, double value)            {return begin + std::snprintf(begin, end - begin, "%.*g", std::numeric_limits<double>::max_digits10, value);}
+template<>  inline char* printValue<long double>(char* begin, char* end, long double value)  {return begin + std::snprintf(begin, end - begin, "%.*Lg", std::numeric_limits<long double>::max_digits10, value);}
+#endif
 
-template<>  inline float                   scanValue<float>(char const* buffer, char** end)                   {return std::strtof(buffer, end);}
-template<>  inline double                  scanValue<double>(char const* buffer, char** end)                  {return std::strtod(buffer, end);}
-template<>  inline long double             scanValue<long double>(char const* buffer, char** end)             {return std::strtold(buffer, end);}
+template<typename Printer = PrinterInterface>
+class BasicSerializer;
+template<typename Parser = ParserInterface>
+class BasicDeSerializer;
 
-class Serializer;
-class DeSerializer;
+using Serializer    = BasicSerializer<PrinterInterface>;
+using DeSerializer  = BasicDeSerializer<ParserInterface>;
 
 template<TraitType type, typename T, typename I>
 class ApplyActionToParent
 {
     public:
         // Default do nothing.
-        void printParentMembers(Serializer&, T const&)            {}
-        bool scanParentMember(DeSerializer&, I const&, T&)        {return false;}
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>&, T const&)            {}
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>&, I const&, T&, std::size_t&)   {return false;}
 };
 
 template<typename T, typename M, TraitType type = Traits<M>::type>
 class DeSerializeMember
 {
     using ParserToken = ParserInterface::ParserToken;
-    bool used = false;
     public:
-        DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo);
-        // Need to be here. But the default version never actually decodes values.
-        // Only the specializations actually decode values.
-        explicit operator bool() const {return used;}
+        template<typename Parser>
+        DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M T::*> const& memberInfo);
 };
 
-class DeSerializer
+template<typename Parser>
+class BasicDeSerializer
 {
     using ParserToken = ParserInterface::ParserToken;
-    ParserInterface&    parser;
+    Parser&             parser;
     bool                root;
+    int                 uncaught;   // Exceptions in flight when constructed (see ~BasicDeSerializer()).
 
     template<typename T, typename Members, std::size_t... Seq>
-    bool scanEachMember(std::string const& key, T& object, Members const& member, std::index_sequence<Seq...> const&);
+    bool scanEachMember(std::string_view const& key, T& object, Members const& member, std::size_t& nextMember, std::index_sequence<Seq...> const&);
 
     template<typename T, typename... Members>
-    bool scanMembers(std::string const& key, T& object, std::tuple<Members...> const& members);
+    bool scanMembers(std::string_view const& key, T& object, std::tuple<Members...> const& members, std::size_t& nextMember);
 
     template<typename T, typename I, typename Action>
-    bool scanMembers(I const& key, T& object, Action action);
+    bool scanMembers(I const& key, T& object, Action action, std::size_t& nextMember);
     public:
-        DeSerializer(ParserInterface& parser, bool root = true);
-        ~DeSerializer() noexcept(false);
+        BasicDeSerializer(Parser& parser, bool root = true);
+        // A root DeSerializer that builds the object from memory allocated by resource.
+        // See useMemoryResource() (the resource is stored in the parser).
+        BasicDeSerializer(Parser& parser, std::pmr::memory_resource* resource);
+        ~BasicDeSerializer() noexcept(false);
 
         template<typename T>
         void parse(T& object);
 
         template<typename T, typename I>
         bool scanObjectMembers(I const& key, T& object);
+        // nextMember is the index of the member expected next (see scanEachMember()).
+        // It is owned by the caller so each object being scanned keeps its own.
+        template<typename T, typename I>
+        bool scanObjectMembers(I const& key, T& object, std::size_t& nextMember);
 };
 
+/*
+ * Put an object back into its empty state so it can be parsed again (see jsonReparse()).
+ * Memory the object already owns is kept: strings and containers are cleared rather
+ * than replaced, and the members of objects (and their parents) are reset recursively.
+ */
+template<typename T>
+void resetObject(T& object);
+
+/*
+ * Make the std::pmr strings and containers inside object allocate from resource.
+ * Members of objects (and their parents) are visited recursively; a pmr string or
+ * container that uses a different resource is rebuilt in place with resource
+ * (its content is moved across). Elements of pmr containers follow the container.
+ *
+ * When the parser has a memoryResource the DeSerializer calls this on the root object
+ * and on each element it adds to a container, so the whole decoded object lives in the
+ * resource (e.g. a std::pmr::monotonic_buffer_resource that is released in one go).
+ */
+template<typename T>
+void useMemoryResource(T& object, std::pmr::memory_resource* resource);
+template<typename Parser, typename T>
+void useParserMemory(Parser& parser, T& object)
+{
+    if (parser.memoryResource != nullptr)
+    {
+        useMemoryResource(object, parser.memoryResource);
+    }
+}
+
 template<typename T, typename M, TraitType type = Traits<typename std::remove_cv<M>::type>::type>
 class SerializeMember
 {
     public:
-        SerializeMember(PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo);
+        template<typename Printer>
+        SerializeMember(Printer& printer, T const& object, MemberKey const& key, std::pair<char const*, M T::*> const& memberInfo);
 };
 
-class Serializer
+template<typename Printer>
+class BasicSerializer
 {
-    PrinterInterface& printer;
+    Printer&          printer;
     bool              root;
 
     template<typename T, typename Members, std::size_t... Seq>
-    void printEachMember(T const& object, Members const& member, std::index_sequence<Seq...> const&);
+    void printEachMember(T const& object, Members const& member, MemberKey const* keys, std::index_sequence<Seq...> const&);
 
     template<typename T, typename... Members>
     void printMembers(T const& object, std::tuple<Members...> const& members);
@@ -220,8 +401,8 @@ class Serializer
     void printMembers(T const& object, Action action);
 
     public:
-        Serializer(PrinterInterface& printer, bool root = true);
-        ~Serializer();
+        BasicSerializer(Printer& printer, bool root = true);
+        ~BasicSerializer();
 
         template<typename T>
         void print(T const& object);
@@ -231,20 +412,46 @@ class Serializer
 };
 
 /* ------------ ParserInterface ------------------------- */
-inline ParserInterface::ParserToken ParserInterface::getToken()
+template<typename Parser>
+inline ParserInterface::ParserToken ParserInterface::nextToken(Parser& parser)
 {
     ParserToken result  = ParserToken::Error;
 
-    if (pushBack != ParserToken::Error)
+    if (parser.pushBack != ParserToken::Error)
     {
-        std::swap(pushBack, result);
+        std::swap(parser.pushBack, result);
     }
     else
     {
-        result = this->getNextToken();
+        result = parser.getNextToken();
     }
     return result;
 }
+template<typename Parser, typename T>
+inline bool ParserInterface::tryGetValueWith(Parser& parser, T& value)
+{
+    ParserToken token = nextToken(parser);
+    if (token != ParserToken::Value)
+    {
+        parser.pushBackToken(token);
+        return false;
+    }
+    parser.getValue(value);
+    return true;
+}
+template<typename CharTraits, typename Allocator>
+inline bool ParserInterface::tryGetValue(std::basic_string<char, CharTraits, Allocator>& value)
+{
+    ParserToken token = getToken();
+    if (token != ParserToken::Value)
+    {
+        pushBackToken(token);
+        return false;
+    }
+    std::string_view    view = getValueView();
+    value.assign(view.data(), view.size());
+    return true;
+}
 inline void ParserInterface::pushBackToken(ParserToken token)
 {
     if (pushBack != ParserToken::Error)
@@ -255,9 +462,11 @@ inline void ParserInterface::pushBackToken(ParserToken token)
 }
 /* ------------ DeSerializer ------------------------- */
 
-inline DeSerializer::DeSerializer(ParserInterface& parser, bool root)
+template<typename Parser>
+inline BasicDeSerializer<Parser>::BasicDeSerializer(Parser& parser, bool root)
     : parser(parser)
     , root(root)
+    , uncaught(std::uncaught_exceptions())
 {
     if (root)
     {
@@ -267,16 +476,26 @@ inline DeSerializer::DeSerializer(ParserInterface& parser, bool root)
         //
         //  Note: We also need to take care of arrays at the top level
         //  We will get that in the next version
-        if (parser.getToken() != ParserToken::DocStart)
+        if (ParserInterface::nextToken(parser) != ParserToken::DocStart)
         {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializer::DeSerializer: Invalid Doc Start");
         }
     }
 }
-inline DeSerializer::~DeSerializer() noexcept(false)
+template<typename Parser>
+inline BasicDeSerializer<Parser>::BasicDeSerializer(Parser& parser, std::pmr::memory_resource* resource)
+    : BasicDeSerializer(parser, true)
 {
-    if (root)
+    parser.memoryResource = resource;
+}
+template<typename Parser>
+inline BasicDeSerializer<Parser>::~BasicDeSerializer() noexcept(false)
+{
+    // If parsing failed an exception is already in flight; throwing again would terminate.
+    // Compare with the count at construction: the DeSerializer may have been created
+    // while unwinding (in a destructor) and then completed normally.
+    if (root && std::uncaught_exceptions() == uncaught)
     {
-        if (parser.getToken() != ParserToken::DocEnd)
+        if (ParserInterface::nextToken(parser) != ParserToken::DocEnd)
         {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializer::~DeSerializer: Expected Doc End");
         }
     }
@@ -284,7 +503,8 @@ inline DeSerializer::~DeSerializer() noexcept(false)
 
 /* ------------ Serializer ------------------------- */
 
-inline Serializer::Serializer(PrinterInterface& printer, bool root)
+template<typename Printer>
+inline BasicSerializer<Printer>::BasicSerializer(Printer& printer, bool root)
     : printer(printer)
     , root(root)
 {
@@ -293,7 +513,8 @@ inline Serializer::Serializer(PrinterInterface& printer, bool root)
         printer.openDoc();
     }
 }
-inline Serializer::~Serializer()
+template<typename Printer>
+inline BasicSerializer<Printer>::~BasicSerializer()
 {
     if (root)
     {
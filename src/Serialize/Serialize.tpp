@@ -6,6 +6,12 @@
 //#include <cstdlib>
 //#include "Traits.h"
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <type_traits>
 
 
 namespace ThorsAnvil
@@ -19,37 +25,61 @@ template<typename T, typename I>
 class ApplyActionToParent<TraitType::Parent, T, I>
 {
     public:
-        void printParentMembers(Serializer& serializer, T const& object)
+        template<typename Printer>
+        void printParentMembers(BasicSerializer<Printer>& serializer, T const& object)
         {
             serializer.printObjectMembers(static_cast<typename Traits<T>::Parent const&>(object));
         }
-        bool scanParentMember(DeSerializer& deSerializer, I const& key, T& object)
+        template<typename Parser>
+        bool scanParentMember(BasicDeSerializer<Parser>& deSerializer, I const& key, T& object, std::size_t& nextMember)
         {
-            return deSerializer.scanObjectMembers(key, static_cast<typename Traits<T>::Parent&>(object));
+            return deSerializer.scanObjectMembers(key, static_cast<typename Traits<T>::Parent&>(object), nextMember);
         }
 };
+/* ------------ ReserveMembers ------------------------- */
+/*
+ * Containers whose Traits<T>::getMembers() object has a reserve(parser, object)
+ * member are given the chance to reserve space (see MemberInserter in SerUtil.h)
+ * once the map/array has been opened. Other types do nothing.
+ */
+template<typename T, typename Parser, typename = void>
+struct ReserveMembers
+{
+    static void reserve(Parser&, T&)        {}
+};
+template<typename T, typename Parser>
+struct ReserveMembers<T, Parser, std::void_t<decltype(Traits<T>::getMembers().reserve(std::declval<Parser&>(), std::declval<T&>()))>>
+{
+    static void reserve(Parser& parser, T& object)
+    {
+        Traits<T>::getMembers().reserve(parser, object);
+    }
+};
+
 /* ------------ DeSerializationForBlock ------------------------- */
 
 /*
  * The default Block is a mapping of "Map" to "Object"
  * We expect an OpenMap followed by a set of Key/Value pairs followed by CloseMap
  */
-template<TraitType traitType, typename T>
+template<TraitType traitType, typename T, typename Parser>
 class DeSerializationForBlock
 {
     static_assert(
         traitType != TraitType::Invalid,
         "Invalid Serialize TraitType. This usually means you have not define ThorsAnvil::Serialize::Traits<Your Type>"
     );
-    DeSerializer&    parent;
-    ParserInterface& parser;
-    std::string      key;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
+    std::string_view            key;
+    std::size_t                 nextMember;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
+            , nextMember(0)
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
+            ParserInterface::ParserToken    tokenType = ParserInterface::nextToken(parser);
 
             if (tokenType != ParserInterface::ParserToken::MapStart)
             {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Map>::DeSerializationForBlock: Invalid Object Start");
@@ -58,9 +88,10 @@ class DeSerializationForBlock
 
         void scanObject(T& object)
         {
+            ReserveMembers<T, Parser>::reserve(parser, object);
             while (hasMoreValue())
             {
-                if (!parent.scanObjectMembers(key, object))
+                if (!parent.scanObjectMembers(key, object, nextMember))
                 {
                     parser.ignoreValue();
                 }
@@ -68,14 +99,16 @@ class DeSerializationForBlock
         }
         bool hasMoreValue()
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
+            ParserInterface::ParserToken    tokenType = ParserInterface::nextToken(parser);
             bool                            result    = tokenType != ParserInterface::ParserToken::MapEnd;
             if (result)
             {
                 if (tokenType != ParserInterface::ParserToken::Key)
                 {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Map>::hasMoreValue: Expecting key token");
                 }
-                key = parser.getKey();
+                // The key is a view into the parser buffer.
+                // It is only used to find the member before the value is read.
+                key = parser.getKeyView();
             }
 
             return result;
@@ -87,23 +120,21 @@ class DeSerializationForBlock
  * This is only used at the top level.
  * There is no open or close. Just a single value is expected.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Value, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Value, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
         void scanObject(T& object)
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
-            if (tokenType != ParserInterface::ParserToken::Value)
+            if (!parser.tryGetValue(object))
             {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Value>::DeSerializationForBlock: Invalid Object");
             }
-            parser.getValue(object);
         }
 };
 /*
@@ -111,24 +142,22 @@ class DeSerializationForBlock<TraitType::Value, T>
  * This is only used at the top level.
  * There is no open or close. Just a single value is expected.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Enum, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Enum, T, Parser>
 {
-    DeSerializer&       parent;
-    ParserInterface&    parser;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
         {}
         void scanObject(T& object)
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
-            if (tokenType != ParserInterface::ParserToken::Value)
+            std::string     objectValue;
+            if (!parser.tryGetValue(objectValue))
             {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock: Invalid Object");
             }
-            std::string     objectValue;
-            parser.getValue(objectValue);
 
             object = Traits<T>::getValue(objectValue, "ThorsAnvil::Serialize::DeSerializationForBlock<Enum>::DeSerializationForBlock:");
         }
@@ -140,19 +169,19 @@ class DeSerializationForBlock<TraitType::Enum, T>
  * This made it different enough that combining this into a single
  * function was messy.
  */
-template<typename T>
-class DeSerializationForBlock<TraitType::Array, T>
+template<typename T, typename Parser>
+class DeSerializationForBlock<TraitType::Array, T, Parser>
 {
-    DeSerializer&    parent;
-    ParserInterface& parser;
-    std::size_t      index;
+    BasicDeSerializer<Parser>&  parent;
+    Parser&                     parser;
+    std::size_t                 index;
     public:
-        DeSerializationForBlock(DeSerializer& parent, ParserInterface& parser)
+        DeSerializationForBlock(BasicDeSerializer<Parser>& parent, Parser& parser)
             : parent(parent)
             , parser(parser)
             , index(-1)
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
+            ParserInterface::ParserToken    tokenType = ParserInterface::nextToken(parser);
 
             if (tokenType != ParserInterface::ParserToken::ArrayStart)
             {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializationForBlock<Array>::DeSerializationForBlock: Invalid Object Start");
@@ -161,6 +190,7 @@ class DeSerializationForBlock<TraitType::Array, T>
 
         void scanObject(T& object)
         {
+            ReserveMembers<T, Parser>::reserve(parser, object);
             while (hasMoreValue())
             {
                 parent.scanObjectMembers(index, object);
@@ -168,7 +198,7 @@ class DeSerializationForBlock<TraitType::Array, T>
         }
         bool hasMoreValue()
         {
-            ParserInterface::ParserToken    tokenType = parser.getToken();
+            ParserInterface::ParserToken    tokenType = ParserInterface::nextToken(parser);
             bool                            result    = tokenType != ParserInterface::ParserToken::ArrayEnd;
             if (result)
             {
@@ -182,128 +212,475 @@ class DeSerializationForBlock<TraitType::Array, T>
 /* ------------ DeSerializeMember ------------------------- */
 
 template<typename T, typename M, TraitType type>
-DeSerializeMember<T, M, type>::DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Parser>
+DeSerializeMember<T, M, type>::DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M T::*> const& memberInfo)
 {
     static_assert(type != TraitType::Invalid, "Trying to de-serialize an object that does not have a ThorsAnvil::Serialize::Trait<> defined."
                                               "Look at macro ThorsAnvil_MakeTrait() for more information.");
 
-    if (key.compare(memberInfo.first) == 0)
-    {
-        used = true;
-        DeSerializer    deSerializer(parser, false);
-        deSerializer.parse(object.*(memberInfo.second));
-    }
+    BasicDeSerializer<Parser>   deSerializer(parser, false);
+    deSerializer.parse(object.*(memberInfo.second));
 }
 
 template<typename T, typename M>
 class DeSerializeMember<T, M, TraitType::Value>
 {
-    bool used = false;
     public:
-        DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+        template<typename Parser>
+        DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M T::*> const& memberInfo)
         {
-            if (key.compare(memberInfo.first) == 0)
-            {
-                used = true;
-                ParserInterface::ParserToken tokenType = parser.getToken();
-                if (tokenType != ParserInterface::ParserToken::Value)
-                {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
-                }
-
-                parser.getValue(object.*(memberInfo.second));
+            if (!parser.tryGetValue(object.*(memberInfo.second)))
+            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
             }
         }
-        DeSerializeMember(ParserInterface& parser, std::string const& key, T&, std::pair<char const*, M*> const& memberInfo)
+        template<typename Parser>
+        DeSerializeMember(Parser& parser, T&, std::pair<char const*, M*> const& memberInfo)
         {
-            if (key.compare(memberInfo.first) == 0)
-            {
-                used = true;
-                ParserInterface::ParserToken tokenType = parser.getToken();
-                if (tokenType != ParserInterface::ParserToken::Value)
-                {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
-                }
-
-                parser.getValue(*(memberInfo.second));
+            if (!parser.tryGetValue(*(memberInfo.second)))
+            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
             }
         }
-        explicit operator bool() const {return used;}
 };
 template<typename T, typename M>
 class DeSerializeMember<T, M, TraitType::Enum>
 {
-    bool used = false;
     public:
-        DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+        template<typename Parser>
+        DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M T::*> const& memberInfo)
         {
-            if (key.compare(memberInfo.first) == 0)
-            {
-                used = true;
-                ParserInterface::ParserToken tokenType = parser.getToken();
-                if (tokenType != ParserInterface::ParserToken::Value)
-                {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
-                }
-                std::string     objectValue;
-                parser.getValue(objectValue);
-
-                object.*(memberInfo.second) = Traits<M>::getValue(objectValue, "ThorsAnvil::Serialize::DeSerializeMember<T,M,Enum>::DeSerializeMember:");
+            std::string     objectValue;
+            if (!parser.tryGetValue(objectValue))
+            {   throw std::runtime_error("ThorsAnvil::Serialize::DeSerializeMember::DeSerializeMember: Expecting Value Token");
             }
+
+            object.*(memberInfo.second) = Traits<M>::getValue(objectValue, "ThorsAnvil::Serialize::DeSerializeMember<T,M,Enum>::DeSerializeMember:");
         }
-        explicit operator bool() const {return used;}
 };
 
+template<typename Parser, typename T, typename M>
+DeSerializeMember<T, M> make_DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M*> const& memberInfo)
+{
+    return DeSerializeMember<T, M>(parser, object, memberInfo);
+}
+
+template<typename Parser, typename T, typename M>
+DeSerializeMember<T, M> make_DeSerializeMember(Parser& parser, T& object, std::pair<char const*, M T::*> const& memberInfo)
+{
+    return DeSerializeMember<T, M>(parser, object, memberInfo);
+}
+
+/* ------------ MemberKeys ------------------------- */
+
+/*
+ * Traits generated by ThorsAnvil_MakeTrait() provide the keys (see Traits.h).
+ * Hand written Traits only have the names in getMembers(); for these the keys
+ * are built (once) from the names.
+ */
+template<typename T, typename = void>
+struct MemberKeys
+{
+    template<typename Members, std::size_t... Seq>
+    static MemberKey const* get(Members const& member, std::index_sequence<Seq...> const&)
+    {
+        static MemberKey const keys[] = {MemberKey{std::get<Seq>(member).first, nullptr, std::strlen(std::get<Seq>(member).first)}...};
+        return keys;
+    }
+};
+template<typename T>
+struct MemberKeys<T, std::void_t<decltype(Traits<T>::getKeys())>>
+{
+    template<typename Members, std::size_t... Seq>
+    static MemberKey const* get(Members const&, std::index_sequence<Seq...> const&)
+    {
+        return Traits<T>::getKeys();
+    }
+};
+
+/* ------------ FlattenedMembers ------------------------- */
+
+/*
+ * For a type declared with ThorsAnvil_ExpandTrait() the members of all its
+ * ancestors are gathered (once per type) into a single tuple, ancestors first,
+ * with each pointer converted into a pointer to a member of T. So the keys of a
+ * deep hierarchy are found with one lookup and printed with one pass.
+ *
+ * This is only available if every level provides its members as a tuple (the
+ * ThorsAnvil_MakeTrait() macros do) and the base is not virtual; otherwise the
+ * Serializer/DeSerializer walk the Parent chain one level at a time.
+ */
+template<typename T, typename = void>
+struct HasMemberTuple: std::false_type {};
+template<typename T>
+struct HasMemberTuple<T, std::void_t<decltype(std::tuple_size<std::decay_t<decltype(Traits<T>::getMembers())>>::value)>>: std::true_type {};
+
+template<typename T, typename P, typename M>
+std::pair<char const*, M T::*> rebaseMember(std::pair<char const*, M P::*> const& member)
+{
+    return {member.first, member.second};
+}
 template<typename T, typename M>
-DeSerializeMember<T, M> make_DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M*> const& memberInfo)
+std::pair<char const*, M*> rebaseMember(std::pair<char const*, M*> const& member)
 {
-    return DeSerializeMember<T, M>(parser, key, object, memberInfo);
+    return member;
 }
+template<typename T, typename Members, std::size_t... Seq>
+auto rebaseMembers(Members const& members, std::index_sequence<Seq...> const&)
+{
+    return std::make_tuple(rebaseMember<T>(std::get<Seq>(members))...);
+}
+template<std::size_t ParentSize, std::size_t... Seq>
+std::array<MemberKey, sizeof...(Seq)> joinMemberKeys(MemberKey const* parent, MemberKey const* own, std::index_sequence<Seq...> const&)
+{
+    return {{(Seq < ParentSize ? parent[Seq] : own[Seq - ParentSize])...}};
+}
+
+template<typename T, typename = void>
+struct FlattenedMembers
+{
+    static constexpr bool available = false;
+};
+template<typename T>
+struct FlattenedMembers<T, std::enable_if_t<Traits<T>::type == TraitType::Map && HasMemberTuple<T>::value>>
+{
+    static constexpr bool           available   = true;
+    static constexpr std::size_t    size        = std::tuple_size<std::decay_t<decltype(Traits<T>::getMembers())>>::value;
+
+    static auto const& getMembers()
+    {
+        return Traits<T>::getMembers();
+    }
+    static MemberKey const* getKeys()
+    {
+        return MemberKeys<T>::get(getMembers(), std::make_index_sequence<size>());
+    }
+};
+template<typename T>
+struct FlattenedMembers<T, std::enable_if_t<Traits<T>::type == TraitType::Parent && HasMemberTuple<T>::value>>
+{
+    using Parent    = typename Traits<T>::Parent;
+    using Base      = FlattenedMembers<Parent>;
+
+    static constexpr bool           available   = Base::available && std::is_convertible<char Parent::*, char T::*>::value;
+    static constexpr std::size_t    ownSize     = std::tuple_size<std::decay_t<decltype(Traits<T>::getMembers())>>::value;
+    static constexpr std::size_t    size        = Base::size + ownSize;
+
+    static auto const& getMembers()
+    {
+        static auto const members = std::tuple_cat(rebaseMembers<T>(Base::getMembers(), std::make_index_sequence<Base::size>()), Traits<T>::getMembers());
+        return members;
+    }
+    static MemberKey const* getKeys()
+    {
+        static auto const keys = joinMemberKeys<Base::size>(Base::getKeys(),
+                                                            MemberKeys<T>::get(Traits<T>::getMembers(), std::make_index_sequence<ownSize>()),
+                                                            std::make_index_sequence<Base::size + ownSize>());
+        return keys.data();
+    }
+};
+
+/* ------------ ResetObject ------------------------- */
 
+/*
+ *  Value:          strings are cleared (keeping their buffer) other values become V{}
+ *  Enum:           V{}
+ *  Map/Parent:     The parent is reset then each (non static) member in getMembers()
+ *  Containers:     Traits<T>::getMembers().reset(object) (see SerUtil.h)
+ * Static members are shared by all objects so they are left alone.
+ */
+template<typename T>
+struct IsString: std::false_type {};
+template<typename CharTraits, typename Allocator>
+struct IsString<std::basic_string<char, CharTraits, Allocator>>: std::true_type {};
+
+template<typename T, typename = void>
+struct HasResetMembers: std::false_type {};
+template<typename T>
+struct HasResetMembers<T, std::void_t<decltype(Traits<T>::getMembers().reset(std::declval<T&>()))>>: std::true_type {};
+
+template<typename T, typename C, typename M>
+void resetMember(T& object, std::pair<char const*, M C::*> const& member)
+{
+    resetObject(object.*(member.second));
+}
 template<typename T, typename M>
-DeSerializeMember<T, M> make_DeSerializeMember(ParserInterface& parser, std::string const& key, T& object, std::pair<char const*, M T::*> const& memberInfo)
+void resetMember(T&, std::pair<char const*, M*> const&)
+{}
+template<typename T, typename Members, std::size_t... Seq>
+void resetMembers(T& object, Members const& members, std::index_sequence<Seq...> const&)
 {
-    return DeSerializeMember<T, M>(parser, key, object, memberInfo);
+    auto discard = {0, (resetMember(object, std::get<Seq>(members)),1)...};
+    (void)discard;
 }
 
+template<typename T>
+inline void resetObject(T& object)
+{
+    constexpr TraitType type = Traits<T>::type;
+    static_assert(type != TraitType::Invalid, "Trying to reset an object that does not have a ThorsAnvil::Serialize::Trait<> defined.");
+
+    if constexpr (IsString<T>::value)
+    {
+        object.clear();
+    }
+    else if constexpr (type == TraitType::Value || type == TraitType::Enum)
+    {
+        object = T{};
+    }
+    else
+    {
+        if constexpr (type == TraitType::Parent)
+        {
+            resetObject(static_cast<typename Traits<T>::Parent&>(object));
+        }
+        if constexpr (HasMemberTuple<T>::value)
+        {
+            resetMembers(object, Traits<T>::getMembers(), std::make_index_sequence<std::tuple_size<std::decay_t<decltype(Traits<T>::getMembers())>>::value>());
+        }
+        else if constexpr (HasResetMembers<T>::value)
+        {
+            Traits<T>::getMembers().reset(object);
+        }
+    }
+}
+
+/* ------------ UseMemoryResource ------------------------- */
+
+/*
+ *  pmr types:      Rebuilt in place with resource (unless they already use it)
+ *                  Elements that are objects (they can not be given an allocator) are then visited
+ *  Map/Parent:     The parent then each (non static) member in getMembers()
+ *  std::array:     Each element
+ *  Others:         Left alone (they do not use a std::pmr::memory_resource)
+ */
+template<typename T, typename = void>
+struct UsesPolymorphicAllocator: std::false_type {};
+template<typename T>
+struct UsesPolymorphicAllocator<T, std::void_t<typename T::allocator_type>>
+    : std::is_same<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::allocator_type::value_type>>
+{};
+template<typename T, typename = void>
+struct HoldsObjects: std::false_type {};
+template<typename T>
+struct HoldsObjects<T, std::void_t<typename T::value_type>>
+    : std::integral_constant<bool, (Traits<typename T::value_type>::type == TraitType::Map || Traits<typename T::value_type>::type == TraitType::Parent)
+                                && !std::uses_allocator<typename T::value_type, typename T::allocator_type>::value
+                                && !std::is_const<std::remove_reference_t<decltype(*std::declval<T&>().begin())>>::value>
+{};
+template<typename T>
+struct IsStdArray: std::false_type {};
+template<typename T, std::size_t N>
+struct IsStdArray<std::array<T, N>>: std::true_type {};
+
+template<typename T, typename C, typename M>
+void useMemberResource(T& object, std::pair<char const*, M C::*> const& member, std::pmr::memory_resource* resource)
+{
+    // const members (the key of a map element) can not be rebuilt.
+    if constexpr (!std::is_const<M>::value)
+    {
+        useMemoryResource(object.*(member.second), resource);
+    }
+}
+template<typename T, typename M>
+void useMemberResource(T&, std::pair<char const*, M*> const&, std::pmr::memory_resource*)
+{}
+template<typename T, typename Members, std::size_t... Seq>
+void useMembersResource(T& object, Members const& members, std::pmr::memory_resource* resource, std::index_sequence<Seq...> const&)
+{
+    auto discard = {0, (useMemberResource(object, std::get<Seq>(members), resource),1)...};
+    (void)discard;
+}
+
+template<typename T>
+inline void useMemoryResource(T& object, std::pmr::memory_resource* resource)
+{
+    constexpr TraitType type = Traits<T>::type;
+    static_assert(type != TraitType::Invalid, "Trying to use a memory resource for an object that does not have a ThorsAnvil::Serialize::Trait<> defined.");
+
+    if constexpr (UsesPolymorphicAllocator<T>::value)
+    {
+        // The allocator of a pmr object can not be changed after it is constructed.
+        // So a new object is built with resource and replaces the original.
+        if (object.get_allocator().resource() != resource)
+        {
+            T   rebuilt(std::move(object), resource);
+            object.~T();
+            new (&object) T(std::move(rebuilt));
+        }
+        if constexpr (HoldsObjects<T>::value)
+        {
+            for (auto& value: object)
+            {
+                useMemoryResource(value, resource);
+            }
+        }
+    }
+    else if constexpr (type == TraitType::Map || type == TraitType::Parent)
+    {
+        if constexpr (type == TraitType::Parent)
+        {
+            useMemoryResource(static_cast<typename Traits<T>::Parent&>(object), resource);
+        }
+        if constexpr (HasMemberTuple<T>::value)
+        {
+            useMembersResource(object, Traits<T>::getMembers(), resource, std::make_index_sequence<std::tuple_size<std::decay_t<decltype(Traits<T>::getMembers())>>::value>());
+        }
+    }
+    else if constexpr (IsStdArray<T>::value)
+    {
+        for (auto& value: object)
+        {
+            useMemoryResource(value, resource);
+        }
+    }
+}
+
+/* ------------ MemberKeyTable ------------------------- */
+
+/*
+ * Maps a member name to its position in the Traits<T>::getMembers() tuple.
+ * The names are sorted once (per type) so a key is found with a binary
+ * search rather than being compared against every member.
+ *
+ * Most producers write the members in the order they are declared.
+ * So find() first compares the key against the expected member (the one
+ * after the last match) and only does the binary search on a miss.
+ */
+template<typename Members, std::size_t... Seq>
+class MemberKeyTable
+{
+    using Entry = std::pair<char const*, std::size_t>;
+    std::array<Entry, sizeof...(Seq)>           table;
+    std::array<MemberKey, sizeof...(Seq)>       declared;
+    public:
+        static constexpr std::size_t    notFound = sizeof...(Seq);
+
+        MemberKeyTable(Members const& members)
+            : table{{Entry(std::get<Seq>(members).first, Seq)...}}
+            , declared{{MemberKey{std::get<Seq>(members).first, nullptr, std::strlen(std::get<Seq>(members).first)}...}}
+        {
+            // Stable so that if a name is repeated (a member hiding a parent member) the first one is found.
+            std::stable_sort(std::begin(table), std::end(table), [](Entry const& lhs, Entry const& rhs){return std::strcmp(lhs.first, rhs.first) < 0;});
+        }
+        std::size_t find(std::string_view const& key, std::size_t expected) const
+        {
+            if (expected < notFound && key == std::string_view(declared[expected].name, declared[expected].size))
+            {
+                return expected;
+            }
+            return find(key);
+        }
+        std::size_t find(std::string_view const& key) const
+        {
+            auto find = std::lower_bound(std::begin(table), std::end(table), key, [](Entry const& lhs, std::string_view const& rhs){return rhs.compare(lhs.first) > 0;});
+            if (find == std::end(table) || key.compare(find->first) != 0)
+            {
+                return notFound;
+            }
+            return find->second;
+        }
+};
+
 /* ------------ DeSerializer ------------------------- */
+template<std::size_t Index, typename Parser, typename T, typename Members>
+void deSerializeMemberAt(Parser& parser, T& object, Members const& member)
+{
+    make_DeSerializeMember(parser, object, std::get<Index>(member));
+}
+
+/*
+ * The key is looked up in the (sorted) MemberKeyTable to get the index of the member.
+ * The index selects the decoder from a table generated at compile time; so each key
+ * results in a single call to decode the correct member.
+ *
+ * The member after the last match (nextMember) is tried first. It is kept by the
+ * DeSerializationForBlock scanning the object and wraps back to the first member
+ * after the last one, so keys that arrive in declaration order are matched with a
+ * single compare.
+ */
+template<typename Parser>
 template<typename T, typename Members, std::size_t... Seq>
-inline bool DeSerializer::scanEachMember(std::string const& key, T& object, Members const& member, std::index_sequence<Seq...> const&)
+inline bool BasicDeSerializer<Parser>::scanEachMember(std::string_view const& key, T& object, Members const& member, std::size_t& nextMember, std::index_sequence<Seq...> const&)
 {
-    auto memberCheck = {static_cast<bool>(make_DeSerializeMember(parser, key, object, std::get<Seq>(member)))...};
-    return std::find(std::begin(memberCheck), std::end(memberCheck), true) != std::end(memberCheck);
+    using Decoder   = void (*)(Parser&, T&, Members const&);
+    using KeyTable  = MemberKeyTable<Members, Seq...>;
+
+    static KeyTable const       keyTable(member);
+    static constexpr Decoder    decoder[] = {&deSerializeMemberAt<Seq, Parser, T, Members>...};
+
+    std::size_t index = keyTable.find(key, nextMember);
+    if (index == KeyTable::notFound)
+    {
+        return false;
+    }
+    nextMember = (index + 1 == KeyTable::notFound) ? 0 : index + 1;
+    decoder[index](parser, object, member);
+    return true;
 }
 
+template<typename Parser>
 template<typename T, typename... Members>
-inline bool DeSerializer::scanMembers(std::string const& key, T& object, std::tuple<Members...> const& members)
+inline bool BasicDeSerializer<Parser>::scanMembers(std::string_view const& key, T& object, std::tuple<Members...> const& members, std::size_t& nextMember)
 {
-    return scanEachMember(key, object, members, std::make_index_sequence<sizeof...(Members)>());
+    return scanEachMember(key, object, members, nextMember, std::make_index_sequence<sizeof...(Members)>());
 }
 
+template<typename Parser>
 template<typename T, typename I, typename Action>
-inline bool DeSerializer::scanMembers(I const& key, T& object, Action action)
+inline bool BasicDeSerializer<Parser>::scanMembers(I const& key, T& object, Action action, std::size_t&)
 {
-    action(parser, key, object);
+    if constexpr (std::is_invocable_v<Action&, Parser&, I const&, T&>)
+    {
+        action(parser, key, object);
+    }
+    else
+    {
+        // A member extractor that takes the key as a std::string const& (the key was a std::string before it was a view).
+        action(parser, std::string(key), object);
+    }
     return true;
 }
 
+template<typename Parser>
+template<typename T, typename I>
+inline bool BasicDeSerializer<Parser>::scanObjectMembers(I const& key, T& object)
+{
+    std::size_t nextMember = 0;
+    return scanObjectMembers(key, object, nextMember);
+}
+
+template<typename Parser>
 template<typename T, typename I>
-inline bool DeSerializer::scanObjectMembers(I const& key, T& object)
+inline bool BasicDeSerializer<Parser>::scanObjectMembers(I const& key, T& object, std::size_t& nextMember)
 {
-    ApplyActionToParent<Traits<T>::type, T, I>     parentScanner;
+    if constexpr (Traits<T>::type == TraitType::Parent && FlattenedMembers<T>::available)
+    {
+        return scanMembers(key, object, FlattenedMembers<T>::getMembers(), nextMember);
+    }
+    else
+    {
+        ApplyActionToParent<Traits<T>::type, T, I>     parentScanner;
 
-    bool result =  parentScanner.scanParentMember(*this, key, object)
-                || scanMembers(key, object, Traits<T>::getMembers());
-    return result;
+        bool result =  parentScanner.scanParentMember(*this, key, object, nextMember)
+                    || scanMembers(key, object, Traits<T>::getMembers(), nextMember);
+        return result;
+    }
 }
 
+template<typename Parser>
 template<typename T>
-inline void DeSerializer::parse(T& object)
+inline void BasicDeSerializer<Parser>::parse(T& object)
 {
-    DeSerializationForBlock<Traits<T>::type, T>     block(*this, parser);
+    if (root)
+    {
+        useParserMemory(parser, object);
+    }
+    DeSerializationForBlock<Traits<T>::type, T, Parser>     block(*this, parser);
     block.scanObject(object);
 }
 
 /* ------------ SerializerForBlock ------------------------- */
 
-template<TraitType traitType, typename T>
+template<TraitType traitType, typename T, typename Printer>
 class SerializerForBlock
 {
     static_assert(
@@ -311,11 +688,11 @@ class SerializerForBlock
         "Invalid Serialize TraitType. This usually means you have not define ThorsAnvil::Serialize::Traits<Your Type>"
     );
 
-    Serializer&         parent;
-    PrinterInterface&   printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer, T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -332,13 +709,13 @@ class SerializerForBlock
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Value, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Value, T, Printer>
 {
-    PrinterInterface&   printer;
+    Printer&            printer;
     T const&            object;
     public:
-        SerializerForBlock(Serializer&, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>&, Printer& printer,T const& object)
             : printer(printer)
             , object(object)
         {}
@@ -349,13 +726,13 @@ class SerializerForBlock<TraitType::Value, T>
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Enum, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Enum, T, Printer>
 {
-    PrinterInterface&   printer;
+    Printer&            printer;
     T const&            object;
     public:
-        SerializerForBlock(Serializer&, PrinterInterface& printer,T const& object)
+        SerializerForBlock(BasicSerializer<Printer>&, Printer& printer,T const& object)
             : printer(printer)
             , object(object)
         {}
@@ -366,14 +743,14 @@ class SerializerForBlock<TraitType::Enum, T>
         }
 };
 
-template<typename T>
-class SerializerForBlock<TraitType::Array, T>
+template<typename T, typename Printer>
+class SerializerForBlock<TraitType::Array, T, Printer>
 {
-    Serializer&         parent;
-    PrinterInterface& printer;
-    T const&            object;
+    BasicSerializer<Printer>&   parent;
+    Printer&                    printer;
+    T const&                    object;
     public:
-        SerializerForBlock(Serializer& parent, PrinterInterface& printer, T const& object)
+        SerializerForBlock(BasicSerializer<Printer>& parent, Printer& printer, T const& object)
             : parent(parent)
             , printer(printer)
             , object(object)
@@ -393,68 +770,76 @@ class SerializerForBlock<TraitType::Array, T>
 /* ------------ SerializeMember ------------------------- */
 
 template<typename T, typename M, TraitType type>
-SerializeMember<T, M, type>::SerializeMember(PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Printer>
+SerializeMember<T, M, type>::SerializeMember(Printer& printer, T const& object, MemberKey const& key, std::pair<char const*, M T::*> const& memberInfo)
 {
     static_assert(type != TraitType::Invalid, "Trying to serialize an object that does not have a ThorsAnvil::Serialize::Trait<> defined."
                                               "Look at macro ThorsAnvil_MakeTrait() for more information.");
 
-    printer.addKey(memberInfo.first);
+    printer.addKey(key);
 
-    Serializer      serialzier(printer, false);
+    BasicSerializer<Printer>    serialzier(printer, false);
     serialzier.print(object.*(memberInfo.second));
 }
 template<typename T, typename M>
 class SerializeMember<T, M, TraitType::Value>
 {
     public:
-        SerializeMember(PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+        template<typename Printer>
+        SerializeMember(Printer& printer, T const& object, MemberKey const& key, std::pair<char const*, M T::*> const& memberInfo)
         {
-            printer.addKey(memberInfo.first);
+            printer.addKey(key);
             printer.addValue(object.*(memberInfo.second));
         }
-        SerializeMember(PrinterInterface& printer, T const&, std::pair<char const*, M*> const& memberInfo)
+        template<typename Printer>
+        SerializeMember(Printer& printer, T const&, MemberKey const& key, std::pair<char const*, M*> const& memberInfo)
         {
-            printer.addKey(memberInfo.first);
+            printer.addKey(key);
             printer.addValue(*(memberInfo.second));
         }
 };
 
-template<typename T, typename M>
-SerializeMember<T, M> make_SerializeMember(PrinterInterface& printer, T const& object, std::pair<char const*, M*> const& memberInfo)
+template<typename Printer, typename T, typename M>
+SerializeMember<T, M> make_SerializeMember(Printer& printer, T const& object, MemberKey const& key, std::pair<char const*, M*> const& memberInfo)
 {
-    return SerializeMember<T,M>(printer, object, memberInfo);
+    return SerializeMember<T,M>(printer, object, key, memberInfo);
 }
-template<typename T, typename M>
-SerializeMember<T, M> make_SerializeMember(PrinterInterface& printer, T const& object, std::pair<char const*, M T::*> const& memberInfo)
+template<typename Printer, typename T, typename M>
+SerializeMember<T, M> make_SerializeMember(Printer& printer, T const& object, MemberKey const& key, std::pair<char const*, M T::*> const& memberInfo)
 {
-    return SerializeMember<T,M>(printer, object, memberInfo);
+    return SerializeMember<T,M>(printer, object, key, memberInfo);
 }
 
 /* ------------ Serializer ------------------------- */
 
+template<typename Printer>
 template<typename T, typename Members, std::size_t... Seq>
-inline void Serializer::printEachMember(T const& object, Members const& member, std::index_sequence<Seq...> const&)
+inline void BasicSerializer<Printer>::printEachMember(T const& object, Members const& member, MemberKey const* keys, std::index_sequence<Seq...> const&)
 {
-    auto discard = {(make_SerializeMember(printer, object, std::get<Seq>(member)),1)...};
+    auto discard = {(make_SerializeMember(printer, object, keys[Seq], std::get<Seq>(member)),1)...};
     (void)discard;
 }
 
+template<typename Printer>
 template<typename T, typename... Members>
-inline void Serializer::printMembers(T const& object, std::tuple<Members...> const& members)
+inline void BasicSerializer<Printer>::printMembers(T const& object, std::tuple<Members...> const& members)
 {
-    printEachMember(object, members, std::make_index_sequence<sizeof...(Members)>());
+    auto seq = std::make_index_sequence<sizeof...(Members)>();
+    printEachMember(object, members, MemberKeys<T>::get(members, seq), seq);
 }
 
+template<typename Printer>
 template<typename T, typename Action>
-inline void Serializer::printMembers(T const& object, Action action)
+inline void BasicSerializer<Printer>::printMembers(T const& object, Action action)
 {
     action(printer, object);
 }
 
+template<typename Printer>
 template<typename T>
-inline void Serializer::print(T const& object)
+inline void BasicSerializer<Printer>::print(T const& object)
 {
-    SerializerForBlock<Traits<T>::type, T>     block(*this, printer, object);
+    SerializerForBlock<Traits<T>::type, T, Printer>     block(*this, printer, object);
     block.printMembers();
 }
 
@@ -478,15 +863,23 @@ struct IndexType<TraitType::Parent>
 };
 
 
+template<typename Printer>
 template<typename T>
-inline void Serializer::printObjectMembers(T const& object)
+inline void BasicSerializer<Printer>::printObjectMembers(T const& object)
 {
-    typedef typename IndexType<Traits<T>::type>::IndexInfoType IndexInfoType;
+    if constexpr (Traits<T>::type == TraitType::Parent && FlattenedMembers<T>::available)
+    {
+        printEachMember(object, FlattenedMembers<T>::getMembers(), FlattenedMembers<T>::getKeys(), std::make_index_sequence<FlattenedMembers<T>::size>());
+    }
+    else
+    {
+        typedef typename IndexType<Traits<T>::type>::IndexInfoType IndexInfoType;
 
-    ApplyActionToParent<Traits<T>::type, T, IndexInfoType>     parentPrinter;
+        ApplyActionToParent<Traits<T>::type, T, IndexInfoType>     parentPrinter;
 
-    parentPrinter.printParentMembers(*this, object);
-    printMembers(object, Traits<T>::getMembers());
+        parentPrinter.printParentMembers(*this, object);
+        printMembers(object, Traits<T>::getMembers());
+    }
 }
 
     }
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <tuple>
+#include <cstddef>
 
 /*
  * Macros for counting the number of arguments
@@ -105,6 +106,8 @@
  * THOR_TYPEACTION:      Declares a type to hold the name and a pointer to the internal object.
  * THOR_VALUEACTION:     Declares an initialization of the Type putting the name and the pointer
  *                  into the object
+ * THOR_KEYACTION:       Declares a MemberKey (the name, the name in quotes and its length)
+ *                  all generated at compile time.
  */
 #define BUILDTEMPLATETYPEPARAM(Act, Count)      ALT_REP_OF_N(Act, ,  ,  , Count)
 #define BUILDTEMPLATETYPEVALUE(Act, Count)      ALT_REP_OF_N(Act, , <, >, Count)
@@ -113,9 +116,11 @@
 #define THOR_TYPEACTION(TC, Type, Member)       std::pair<char const*, decltype(&Type BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, TC) ::Member)>
 #define THOR_VALUEACTION(TC, Type, Member)      { QUOTE(Member), &Type BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, TC) ::Member }
 #define THOR_NAMEACTION(TC, Type, Member)       #Member
+#define THOR_KEYACTION(TC, Type, Member)        { QUOTE(Member), "\"" QUOTE(Member) "\"", sizeof(QUOTE(Member)) - 1 }
 #define LAST_THOR_TYPEACTION(TC, Type)          void*
 #define LAST_THOR_VALUEACTION(TC, Type)         {nullptr}
 #define LAST_THOR_NAMEACTION(TC, Type)          nullptr
+#define LAST_THOR_KEYACTION(TC, Type)           { nullptr, nullptr, 0 }
 
 #define THOR_TYPENAMEPARAMACTION(Ex, Id)        typename T ## Id
 #define THOR_TYPENAMEVALUEACTION(Ex, Id)        T ## Id
@@ -154,6 +159,13 @@ class Traits<DataType BUILDTEMPLATETYPEVALUE(THOR_TYPENAMEVALUEACTION, Count) >
                                             };                          \
             return members;                                             \
         }                                                               \
+        static MemberKey const* getKeys()                               \
+        {                                                               \
+            static constexpr MemberKey keys[] = {                       \
+                        REP_N(THOR_KEYACTION, Count, DataType, __VA_ARGS__)         \
+                                            };                          \
+            return keys;                                                \
+        }                                                               \
 };                                                                      \
 }}                                                                      \
 ALT_REP_OF_N(THOR_CHECK_ASSERT, DataType, , , Count)
@@ -221,6 +233,21 @@ namespace ThorsAnvil
     {
 
 enum class TraitType {Invalid, Parent, Value, Map, Array, Enum};
+
+/*
+ * The name of a member as used as a key when serializing.
+ *      name:   The member name (null terminated)
+ *      quoted: The member name in double quotes (ready to be used by Json) or nullptr
+ *      size:   The length of name
+ * For types declared with ThorsAnvil_MakeTrait() these are compile time constants
+ * available from Traits<T>::getKeys() (in the same order as getMembers()).
+ */
+struct MemberKey
+{
+    char const*     name;
+    char const*     quoted;
+    std::size_t     size;
+};
 template<typename T>
 class Traits
 {
@@ -244,6 +271,10 @@ class Traits
         // So I use a static member function with a static variable
         // which can be defined in-line within the traits class and
         // does not need a separate declaration in a compilation unit.
+        //
+        // Types defined with the ThorsAnvil_MakeTrait macros also define
+        // static MemberKey const* getKeys()
+        // The key for each member in the same order as getMembers().
 };
 
 /*
@@ -267,6 +298,11 @@ template<> class Traits<long double>            {public: static constexpr TraitT
 template<> class Traits<bool>                   {public: static constexpr TraitType type = TraitType::Value;};
 
 template<> class Traits<std::string>            {public: static constexpr TraitType type = TraitType::Value;};
+// Strings that use another allocator (std::pmr::string).
+// The parser/printer read and write these through a std::string_view (see Serialize.h).
+template<typename CharTraits, typename Allocator>
+class Traits<std::basic_string<char, CharTraits, Allocator>>
+{public: static constexpr TraitType type = TraitType::Value;};
 
 /*
  * For object that are serialized as Json Array
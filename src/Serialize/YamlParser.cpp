@@ -30,6 +30,15 @@ YamlParser::YamlParser(std::istream& input, ParseType parseStrictness)
     yaml_parser_set_input(&parser, thorsanvilYamlStreamReader, this);
 }
 
+YamlParser::YamlParser(std::string_view input, ParseType parseStrictness)
+    : ParserInterface(parseStrictness)
+    , first(true)
+    , error(false)
+{
+    yaml_parser_initialize(&parser);
+    yaml_parser_set_input_string(&parser, reinterpret_cast<unsigned char const*>(input.data()), input.size());
+}
+
 YamlParser::~YamlParser()
 {
     if (!first)
@@ -155,14 +164,26 @@ void YamlParser::generateParsingException(std::string const& msg)
     throw std::runtime_error(msg);
 }
 
+// The scalar stays valid until the next event is parsed.
+// The event data is a union so check it is a scalar before reading it.
+std::string_view YamlParser::getScalar()
+{
+    if (event.type != YAML_SCALAR_EVENT)
+    {
+        throw std::runtime_error("ThorsAnvil::Serialize::YamlParser: Not a scalar");
+    }
+    return std::string_view(reinterpret_cast<char const*>(event.data.scalar.value), event.data.scalar.length);
+}
+
 std::string YamlParser::getString()
 {
 //int   plain_implicit
 //int   quoted_implicit
 //yaml_scalar_style_t   style
 
-    char const* buffer  = reinterpret_cast<char const*>(event.data.scalar.value);
-    std::size_t length  = event.data.scalar.length;
+    std::string_view    scalar  = getScalar();
+    char const*         buffer  = scalar.data();
+    std::size_t         length  = scalar.size();
 
 /*
     char const* tag    = event.data.scalar.tag    ? (char const*)event.data.scalar.tag    : "NULL";
@@ -183,15 +204,25 @@ std::string YamlParser::getKey()
     return getString();
 }
 
+std::string_view YamlParser::getKeyView()
+{
+    return getScalar();
+}
+
+std::string_view YamlParser::getValueView()
+{
+    return getScalar();
+}
+
 template<typename T>
 T YamlParser::scan()
 {
-    char const* buffer  = reinterpret_cast<char const*>(event.data.scalar.value);
-    std::size_t length  = event.data.scalar.length;
-    char*       end;
+    std::string_view    scalar  = getScalar();
+    char const*         buffer  = scalar.data();
+    std::size_t         length  = scalar.size();
 
-    T   value = scanValue<T>(buffer, &end);
-    if (buffer + length != end)
+    T   value;
+    if (!scanValue(buffer, buffer + length, value))
     {
         throw std::runtime_error("ThorsAnvil::Serialize::YamlParser: Not an integer");
     }
@@ -215,8 +246,9 @@ void YamlParser::getValue(long double& value)           {value   = scan<long dou
 
 void YamlParser::getValue(bool& value)
 {
-    char const* buffer  = reinterpret_cast<char const*>(event.data.scalar.value);
-    std::size_t length  = event.data.scalar.length;
+    std::string_view    scalar  = getScalar();
+    char const*         buffer  = scalar.data();
+    std::size_t         length  = scalar.size();
 
     if (length == 4 && strncmp(buffer, "true", 4) == 0)
     {
@@ -237,4 +269,22 @@ void YamlParser::getValue(std::string& value)
     value = getString();
 }
 
+bool YamlParser::tryGetValue(short& value)                   {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(int& value)                     {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(long& value)                    {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(long long& value)               {return tryGetValueWith(*this, value);}
+
+bool YamlParser::tryGetValue(unsigned short& value)          {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(unsigned int& value)            {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(unsigned long& value)           {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(unsigned long long& value)      {return tryGetValueWith(*this, value);}
+
+bool YamlParser::tryGetValue(float& value)                   {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(double& value)                  {return tryGetValueWith(*this, value);}
+bool YamlParser::tryGetValue(long double& value)             {return tryGetValueWith(*this, value);}
+
+bool YamlParser::tryGetValue(bool& value)                    {return tryGetValueWith(*this, value);}
+
+bool YamlParser::tryGetValue(std::string& value)             {return tryGetValueWith(*this, value);}
+
 #endif
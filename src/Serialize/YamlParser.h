@@ -15,6 +15,10 @@
  *      For Objects the order of elements is not important. It looks up the key in the Traits<T>
  *      information to understand which member is being de-serialized but unspecified elements
  *      will not cause an error.
+ *
+ *      The parser can also be constructed directly on a block of memory (std::string_view).
+ *      libyaml then reads from the memory rather than pulling data through the stream.
+ *      The memory must outlive the parser.
  */
 
 #include "SerializeConfig.h"
@@ -23,6 +27,7 @@
 #include "Serialize.h"
 #include <yaml.h>
 #include <istream>
+#include <string_view>
 #include <vector>
 #include <functional>
 
@@ -31,7 +36,7 @@ namespace ThorsAnvil
     namespace Serialize
     {
 
-class YamlParser: public ParserInterface
+class YamlParser final: public ParserInterface
 {
     enum class State {Open, Map, Array};
     std::vector<std::pair<State, int>>  state;
@@ -41,6 +46,7 @@ class YamlParser: public ParserInterface
     bool                error;
 
     std::string getString();
+    std::string_view getScalar();
     void generateParsingException(std::function<bool ()> test, std::string const& msg);
     void generateParsingException(std::string const& msg);
     ParserToken parsingError();
@@ -52,10 +58,13 @@ class YamlParser: public ParserInterface
     T scan();
     public:
         YamlParser(std::istream& input, ParseType parseStrictness = ParseType::Weak);
+        YamlParser(std::string_view input, ParseType parseStrictness = ParseType::Weak);
         virtual ~YamlParser();
 
         virtual ParserToken     getNextToken()                  override;
         virtual std::string     getKey()                        override;
+        virtual std::string_view getKeyView()                   override;
+        virtual std::string_view getValueView()                 override;
 
         virtual void    getValue(short int& value)              override;
         virtual void    getValue(int& value)                    override;
@@ -74,6 +83,25 @@ class YamlParser: public ParserInterface
         virtual void    getValue(bool& value)                   override;
 
         virtual void    getValue(std::string& value)            override;
+
+        using ParserInterface::tryGetValue;
+        virtual bool    tryGetValue(short int& value)               override;
+        virtual bool    tryGetValue(int& value)                     override;
+        virtual bool    tryGetValue(long int& value)                override;
+        virtual bool    tryGetValue(long long int& value)           override;
+
+        virtual bool    tryGetValue(unsigned short int& value)      override;
+        virtual bool    tryGetValue(unsigned int& value)            override;
+        virtual bool    tryGetValue(unsigned long int& value)       override;
+        virtual bool    tryGetValue(unsigned long long int& value)  override;
+
+        virtual bool    tryGetValue(float& value)                   override;
+        virtual bool    tryGetValue(double& value)                  override;
+        virtual bool    tryGetValue(long double& value)             override;
+
+        virtual bool    tryGetValue(bool& value)                    override;
+
+        virtual bool    tryGetValue(std::string& value)             override;
 };
 
     }
@@ -1,7 +1,6 @@
 #include "SerializeConfig.h"
 #ifdef HAVE_YAML
 #include "YamlPrinter.h"
-#include <sstream>
 
 extern "C"
 {
@@ -126,12 +125,8 @@ void YamlPrinter::closeArray()
     state.pop_back();
 }
 
-template<typename T>
-void YamlPrinter::emit(T const& data)
+void YamlPrinter::emit(char const* data, std::size_t size)
 {
-    std::stringstream buffer;
-    buffer << data;
-
     checkYamlResultCode(
         [&](yaml_event_t& event)
         {
@@ -139,8 +134,8 @@ void YamlPrinter::emit(T const& data)
                         &event,
                         NULL,
                         NULL,
-                        reinterpret_cast<yaml_char_t*>(const_cast<char*>(buffer.str().c_str())),
-                        buffer.str().size(),
+                        reinterpret_cast<yaml_char_t*>(const_cast<char*>(data)),
+                        size,
                         1,
                         0,
                         YAML_ANY_SCALAR_STYLE);
@@ -150,6 +145,14 @@ void YamlPrinter::emit(T const& data)
     ++state.back().first;
 }
 
+template<typename T>
+void YamlPrinter::emitNumber(T value)
+{
+    char    buffer[printValueBufferSize];
+    char*   end     = printValue(buffer, buffer + printValueBufferSize, value);
+    emit(buffer, end - buffer);
+}
+
 void YamlPrinter::addKey(std::string const& key)
 {
     if (state.back().second != TraitType::Map && state.back().first % 2 != 1)
@@ -157,25 +160,34 @@ void YamlPrinter::addKey(std::string const& key)
         error = true;
         throw std::runtime_error("ThorsAnvil::Serialize::YamlPrinter: Invalid call to addKey(): Currently not in a map");
     }
-    emit(key);
+    emit(key.data(), key.size());
+}
+void YamlPrinter::addKey(MemberKey const& key)
+{
+    if (state.back().second != TraitType::Map && state.back().first % 2 != 1)
+    {
+        error = true;
+        throw std::runtime_error("ThorsAnvil::Serialize::YamlPrinter: Invalid call to addKey(): Currently not in a map");
+    }
+    emit(key.name, key.size);
 }
 
-void YamlPrinter::addValue(short int value)                     {emit(value);}
-void YamlPrinter::addValue(int value)                           {emit(value);}
-void YamlPrinter::addValue(long int value)                      {emit(value);}
-void YamlPrinter::addValue(long long int value)                 {emit(value);}
+void YamlPrinter::addValue(short int value)                     {emitNumber(value);}
+void YamlPrinter::addValue(int value)                           {emitNumber(value);}
+void YamlPrinter::addValue(long int value)                      {emitNumber(value);}
+void YamlPrinter::addValue(long long int value)                 {emitNumber(value);}
 
-void YamlPrinter::addValue(unsigned short int value)            {emit(value);}
-void YamlPrinter::addValue(unsigned int value)                  {emit(value);}
-void YamlPrinter::addValue(unsigned long int value)             {emit(value);}
-void YamlPrinter::addValue(unsigned long long int value)        {emit(value);}
+void YamlPrinter::addValue(unsigned short int value)            {emitNumber(value);}
+void YamlPrinter::addValue(unsigned int value)                  {emitNumber(value);}
+void YamlPrinter::addValue(unsigned long int value)             {emitNumber(value);}
+void YamlPrinter::addValue(unsigned long long int value)        {emitNumber(value);}
 
-void YamlPrinter::addValue(float value)                         {emit(value);}
-void YamlPrinter::addValue(double value)                        {emit(value);}
-void YamlPrinter::addValue(long double value)                   {emit(value);}
+void YamlPrinter::addValue(float value)                         {emitNumber(value);}
+void YamlPrinter::addValue(double value)                        {emitNumber(value);}
+void YamlPrinter::addValue(long double value)                   {emitNumber(value);}
 
-void YamlPrinter::addValue(bool value)                          {emit(value?"true":"false");}
+void YamlPrinter::addValue(bool value)                          {value ? emit("true", 4) : emit("false", 5);}
 
-void YamlPrinter::addValue(std::string const& value)            {emit(value);}
+void YamlPrinter::addValue(std::string const& value)            {emit(value.data(), value.size());}
 
 #endif
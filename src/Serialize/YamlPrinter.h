@@ -15,7 +15,7 @@ namespace ThorsAnvil
     namespace Serialize
     {
 
-class YamlPrinter: public PrinterInterface
+class YamlPrinter final: public PrinterInterface
 {
     yaml_emitter_t    emitter;
     bool              error;
@@ -23,8 +23,9 @@ class YamlPrinter: public PrinterInterface
 
     void checkYamlResultCode(int code, char const* method, char const* msg);
     void checkYamlResultCode(std::function<int(yaml_event_t&)> init, char const* method, char const* msg);
+    void emit(char const* data, std::size_t size);
     template<typename T>
-    void emit(T const& data);
+    void emitNumber(T value);
     public:
         YamlPrinter(std::ostream& output, OutputType characteristics = OutputType::Default);
         ~YamlPrinter();
@@ -35,7 +36,10 @@ class YamlPrinter: public PrinterInterface
         virtual void openArray(std::size_t size)            override;
         virtual void closeArray()                           override;
 
+        using PrinterInterface::addKey;
+        using PrinterInterface::addValue;
         virtual void addKey(std::string const& key)         override;
+        virtual void addKey(MemberKey const& key)           override;
 
         virtual void addValue(short int value)              override;
         virtual void addValue(int value)                    override;
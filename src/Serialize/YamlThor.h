@@ -9,6 +9,8 @@
  * Usage:
  *      std::cout << yamlExport(object); // converts object to Yaml on an output stream
  *      std::cin  >> yamlImport(object); // converts Yaml to a C++ object from an input stream
+ *      std::cin  >> yamlReparse(object);// same as yamlImport() but the object is reset first
+ *      yamlImportFile(path, object);    // converts Yaml in a file (memory mapped) to a C++ object
  */
 
 #include "SerializeConfig.h"
@@ -18,6 +20,8 @@
 #include "YamlPrinter.h"
 #include "Exporter.h"
 #include "Importer.h"
+#include "MappedFile.h"
+#include <string>
 
 namespace ThorsAnvil
 {
@@ -39,6 +43,20 @@ template<typename T>
 Importer<Yaml, T> yamlImport(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
 {
     return Importer<Yaml, T>(value, parseStrictness);
+}
+template<typename T>
+Importer<Yaml, T> yamlReparse(T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    return Importer<Yaml, T>(value, parseStrictness, true);
+}
+template<typename T>
+void yamlImportFile(std::string const& path, T& value, ParserInterface::ParseType parseStrictness = ParserInterface::ParseType::Weak)
+{
+    MappedFile      file(path);
+    YamlParser      parser(file.data(), parseStrictness);
+    BasicDeSerializer<YamlParser>   deSerializer(parser);
+
+    deSerializer.parse(value);
 }
     }
 }
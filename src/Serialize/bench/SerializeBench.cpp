@@ -0,0 +1,189 @@
+/*
+ * Micro benchmarks (see Makefile).
+ *
+ *      SerializeBench.app                  Run all the benchmarks.
+ *      SerializeBench.app <name>...        Run the named benchmarks.
+ *
+ * Each benchmark checks its result (so the work can not be optimized away)
+ * and prints a rate. The rates are only useful for comparing two builds on
+ * the same machine.
+ */
+
+#include "../JsonParser.h"
+#include "../Serialize.h"
+#include "../Traits.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace TA = ThorsAnvil::Serialize;
+
+namespace SerializeBench
+{
+    struct StructOfScalars
+    {
+        int             theInteger      = 0;
+        double          aNonRealValue   = 0;
+        bool            test            = false;
+        std::string     normalString;
+    };
+}
+ThorsAnvil_MakeTrait(SerializeBench::StructOfScalars, theInteger, aNonRealValue, test, normalString);
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    void report(char const* name, std::size_t count, char const* unit, Clock::time_point start)
+    {
+        double  seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << name << ": " << static_cast<std::size_t>(count / (seconds > 0 ? seconds : 1)) << " " << unit << "/sec\n";
+    }
+
+    /*
+     * Token state machine (JsonParser::getToken()).
+     * An array of small objects that uses every kind of token.
+     */
+    std::string tokenInput()
+    {
+        std::string         input("[");
+        for (int loop = 0; loop < 20000; ++loop)
+        {
+            input += R"({"Key": 1, "Flag": true, "List": [1.5, null, "Text"]},)";
+        }
+        input += "{}]";
+        return input;
+    }
+    // DocStart + ArrayStart + 20000 * (MapStart + 3 Key + 2 Value + ArrayStart + 3 Value + ArrayEnd + MapEnd) + MapStart + MapEnd + ArrayEnd
+    std::size_t const   tokenInputCount = 2 + 20000 * 12 + 3;
+
+    std::size_t countTokens(TA::JsonParser& parser)
+    {
+        std::size_t         count   = 0;
+        for (TA::ParserInterface::ParserToken token = parser.getToken(); token != TA::ParserInterface::ParserToken::DocEnd; token = parser.getToken())
+        {
+            if (token == TA::ParserInterface::ParserToken::Error)
+            {
+                throw std::runtime_error("countTokens: Error token");
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    void tokenCheck(std::size_t count)
+    {
+        if (count != tokenInputCount)
+        {
+            throw std::runtime_error("Token: Wrong number of tokens");
+        }
+    }
+
+    void tokenFlex()
+    {
+        std::string const   input   = tokenInput();
+        std::size_t         count   = 0;
+        auto                start   = Clock::now();
+        for (int loop = 0; loop < 10; ++loop)
+        {
+            std::stringstream   stream(input);
+            TA::JsonParser      parser(stream, TA::ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+            std::size_t         found   = countTokens(parser);
+            tokenCheck(found);
+            count += found;
+        }
+        report("TokenFlex", count, "tokens", start);
+    }
+
+    void tokenFast()
+    {
+        std::string const   input   = tokenInput();
+        std::size_t         count   = 0;
+        auto                start   = Clock::now();
+        for (int loop = 0; loop < 10; ++loop)
+        {
+            TA::JsonParser      parser{std::string_view(input)};
+            std::size_t         found   = countTokens(parser);
+            tokenCheck(found);
+            count += found;
+        }
+        report("TokenFast", count, "tokens", start);
+    }
+
+    /*
+     * Decoding a struct of scalars (each member is read with tryGetValue()).
+     * Through the ParserInterface (virtual calls) and the concrete JsonParser.
+     */
+    template<typename DeSerializer>
+    void structOfScalars(char const* name)
+    {
+        std::string const                   input(R"({"theInteger":34,"aNonRealValue":56.78,"test":true,"normalString":"Done"})");
+        TA::JsonParser                      parser{std::string_view(input)};
+        SerializeBench::StructOfScalars     data;
+        std::size_t const                   count   = 1000000;
+
+        auto                start   = Clock::now();
+        for (std::size_t loop = 0; loop < count; ++loop)
+        {
+            parser.reset(input);
+            DeSerializer    deSerializer(parser);
+            deSerializer.parse(data);
+        }
+        if (data.theInteger != 34 || data.normalString != "Done")
+        {
+            throw std::runtime_error("StructOfScalars: Wrong value");
+        }
+        report(name, count, "objects", start);
+    }
+    void structOfScalarsInterface()
+    {
+        structOfScalars<TA::DeSerializer>("StructOfScalarsInterface");
+    }
+    void structOfScalarsJson()
+    {
+        structOfScalars<TA::BasicDeSerializer<TA::JsonParser>>("StructOfScalarsJson");
+    }
+
+    struct Benchmark
+    {
+        char const*     name;
+        void            (*run)();
+    };
+    Benchmark const     benchmarks[] =
+    {
+        {"TokenFlex",                   &tokenFlex},
+        {"TokenFast",                   &tokenFast},
+        {"StructOfScalarsInterface",    &structOfScalarsInterface},
+        {"StructOfScalarsJson",         &structOfScalarsJson},
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        for (auto const& benchmark: benchmarks)
+        {
+            bool    wanted  = argc == 1;
+            for (int loop = 1; loop < argc; ++loop)
+            {
+                wanted = wanted || std::strcmp(argv[loop], benchmark.name) == 0;
+            }
+            if (wanted)
+            {
+                benchmark.run();
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "SerializeBench: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
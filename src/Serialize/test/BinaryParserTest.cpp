@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "BinaryParser.h"
+#include "BinaryThor.h"
 #include "test/BinaryParserTest.h"
 
 namespace TA=ThorsAnvil::Serialize;
@@ -19,6 +20,29 @@ TEST(BinaryParserTest, ArrayEmpty)
     EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
     EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
 }
+TEST(BinaryParserTest, ArraySizeHint)
+{
+    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x02\x00\x00\x00\x0c\x00\x00\x00\x0d", 16)); // [12, 13]
+    TA::BinaryParser<std::vector<int>>      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(2,                                        parser.getSizeHint());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(BinaryParserTest, ArraySizeHintIsCapped)
+{
+    // A corrupt count (0xFFFFFFFF) followed by only two values.
+    std::stringstream   stream(std::string("\xea\xb0\x50\x2f\xff\xff\xff\xff\x00\x00\x00\x0c\x00\x00\x00\x0d", 16));
+    std::vector<int>    data;
+
+    // Running out of data is reported; the count is not used to allocate memory.
+    EXPECT_THROW(stream >> TA::binImport(data), std::runtime_error);
+    EXPECT_LE(data.capacity(), TA::BinaryParser<std::vector<int>>::sizeHintLimit);
+}
 TEST(BinaryParserTest, ArrayOneValue)
 {
     std::stringstream   stream(std::string("\xea\xb0\x50\x2f\x00\x00\x00\x01\x00\x00\x00\x0c", 12)); // [12]
@@ -0,0 +1,109 @@
+
+#include "gtest/gtest.h"
+#include "JsonArrayWriter.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+namespace TA=ThorsAnvil::Serialize;
+
+namespace
+{
+    std::string noSpace(std::string result)
+    {
+        result.erase(std::remove_if(std::begin(result), std::end(result), [](char x){return ::isspace(x);}), std::end(result));
+        return result;
+    }
+    std::string fileContent(std::string const& path)
+    {
+        std::ifstream       file(path);
+        std::stringstream   content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+TEST(JsonArrayWriterTest, AppendToStream)
+{
+    std::stringstream       stream;
+    TA::JsonArrayWriter     writer(stream);
+
+    EXPECT_EQ("[",                  noSpace(stream.str()));
+    writer.append(1);
+    // Each element is on the stream as soon as it is appended.
+    EXPECT_EQ("[1",                 noSpace(stream.str()));
+    writer.append(std::vector<int>{2, 3});
+    EXPECT_EQ("[1,[2,3]",           noSpace(stream.str()));
+    writer.finish();
+    EXPECT_EQ("[1,[2,3]]",          noSpace(stream.str()));
+    EXPECT_THROW(writer.append(4),  std::runtime_error);
+}
+TEST(JsonArrayWriterTest, EmptyArray)
+{
+    std::stringstream       stream;
+    {
+        TA::JsonArrayWriter writer(stream);
+    }
+    EXPECT_EQ("[]",                 noSpace(stream.str()));
+}
+TEST(JsonArrayWriterTest, ReopenFileAndAppend)
+{
+    std::string             path("JsonArrayWriterTest.json");
+    {
+        TA::JsonArrayWriter writer(path, TA::JsonArrayWriter::Mode::Append);
+        writer.append(1);
+        writer.append(2);
+    }
+    {
+        TA::JsonArrayWriter writer(path, TA::JsonArrayWriter::Mode::Append);
+        writer.append(3);
+    }
+    EXPECT_EQ("[1,2,3]",            noSpace(fileContent(path)));
+
+    std::vector<int>        data;
+    TA::jsonImportFile(path, data);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), data);
+    std::remove(path.c_str());
+}
+TEST(JsonArrayWriterTest, ReopenEmptyArray)
+{
+    std::string             path("JsonArrayWriterTest.json");
+    {
+        std::ofstream       file(path);
+        file << "[ ]\n\n";
+    }
+    {
+        TA::JsonArrayWriter writer(path, TA::JsonArrayWriter::Mode::Append);
+        writer.append(5);
+    }
+    EXPECT_EQ("[5]",                noSpace(fileContent(path)));
+    std::remove(path.c_str());
+}
+TEST(JsonArrayWriterTest, ReopenNotAnArray)
+{
+    std::string             path("JsonArrayWriterTest.json");
+    {
+        std::ofstream       file(path);
+        file << "{\"A\": 1}";
+    }
+    EXPECT_THROW(TA::JsonArrayWriter(path, TA::JsonArrayWriter::Mode::Append), std::runtime_error);
+    EXPECT_EQ("{\"A\": 1}",         fileContent(path));
+    std::remove(path.c_str());
+}
+TEST(JsonArrayWriterTest, CreateReplacesFile)
+{
+    std::string             path("JsonArrayWriterTest.json");
+    {
+        std::ofstream       file(path);
+        file << "[1, 2]";
+    }
+    {
+        TA::JsonArrayWriter writer(path);
+        writer.append(3);
+    }
+    EXPECT_EQ("[3]",                noSpace(fileContent(path)));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,219 @@
+
+#include "gtest/gtest.h"
+#include "JsonFastLexer.h"
+#include "JsonLexemes.h"
+#include "JsonParser.h"
+#include "SerUtil.h"
+#include <map>
+#include <vector>
+
+using ThorsAnvil::Serialize::JsonFastLexer;
+
+TEST(JsonFastLexerTest, ArrayTokens)
+{
+    std::stringstream   stream("[],");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ('[',   lexer.yylex());
+    EXPECT_EQ(']',   lexer.yylex());
+    EXPECT_EQ(',',   lexer.yylex());
+    EXPECT_EQ(0,     lexer.yylex());
+}
+TEST(JsonFastLexerTest, MapTokens)
+{
+    std::stringstream   stream("{}:,");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ('{',   lexer.yylex());
+    EXPECT_EQ('}',   lexer.yylex());
+    EXPECT_EQ(':',   lexer.yylex());
+    EXPECT_EQ(',',   lexer.yylex());
+}
+TEST(JsonFastLexerTest, ValueTokens)
+{
+    std::stringstream   stream(R"("Test" 456 789.123 true false null)");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_STRING,  lexer.yylex());
+    EXPECT_EQ(std::string("\"Test\""), std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_EQ(std::string("456"), std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(std::string("789.123"), std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_TRUE,    lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FALSE,   lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_NULL,    lexer.yylex());
+    EXPECT_EQ(0,                                   lexer.yylex());
+}
+TEST(JsonFastLexerTest, NumberTokens)
+{
+    std::stringstream   stream("0 -1 12e5 -0.5E-3 1.");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(std::string("12e5"), std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(std::string("-0.5E-3"), std::string(lexer.YYText(), lexer.YYLeng()));
+    // Like the flex lexer the '.' is not part of the number if no digits follow.
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_THROW(lexer.yylex(), std::runtime_error);
+}
+TEST(JsonFastLexerTest, StringWithEscapes)
+{
+    std::stringstream   stream(R"(  "\"\\\/\b\f\n\r\t©"  )");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_STRING,  lexer.yylex());
+    EXPECT_EQ(20, lexer.YYLeng());
+    EXPECT_EQ(0,                                   lexer.yylex());
+}
+TEST(JsonFastLexerTest, BadEscape)
+{
+    std::stringstream   stream(R"("\x")");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_THROW(lexer.yylex(), std::runtime_error);
+}
+TEST(JsonFastLexerTest, BadUnicodeEscape)
+{
+    std::stringstream   stream(R"("\u00G0")");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_THROW(lexer.yylex(), std::runtime_error);
+}
+TEST(JsonFastLexerTest, UnterminatedString)
+{
+    std::stringstream   stream(R"("Test)");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_THROW(lexer.yylex(), std::runtime_error);
+}
+TEST(JsonFastLexerTest, InvalidCharacter)
+{
+    std::stringstream   stream("[ # ]");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ('[',   lexer.yylex());
+    EXPECT_THROW(lexer.yylex(), std::runtime_error);
+}
+TEST(JsonFastLexerTest, WhiteSpace)
+{
+    // The same white space as the flex lexer.
+    std::stringstream   stream("[ \t\r\n1\r\n]");
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ('[',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_EQ(']',                                 lexer.yylex());
+}
+TEST(JsonFastLexerTest, TokensSpanningBlocks)
+{
+    // Make sure tokens that cross the boundary of a read block are kept intact.
+    std::string         longString(JsonFastLexer::BlockSize + 17, 'x');
+    longString[100]     = '\\';
+    longString[101]     = 'n';
+    std::string         input = std::string(JsonFastLexer::BlockSize - 3, ' ') + "12345 \"" + longString + "\" true";
+    std::stringstream   stream(input);
+    JsonFastLexer       lexer(&stream);
+
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_EQ(std::string("12345"), std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_STRING,  lexer.yylex());
+    EXPECT_EQ("\"" + longString + "\"", std::string(lexer.YYText(), lexer.YYLeng()));
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_TRUE,    lexer.yylex());
+    EXPECT_EQ(0,                                   lexer.yylex());
+}
+TEST(JsonFastLexerTest, ParserUsingFastLexer)
+{
+    std::stringstream               stream(R"({"Key": [1, 2.5, "Three"]})");
+    ThorsAnvil::Serialize::JsonParser parser(stream, ThorsAnvil::Serialize::ParserInterface::ParseType::Weak, ThorsAnvil::Serialize::JsonParser::LexerType::Fast);
+    using ParserToken = ThorsAnvil::Serialize::ParserInterface::ParserToken;
+
+    EXPECT_EQ(ParserToken::DocStart,    parser.getToken());
+    EXPECT_EQ(ParserToken::MapStart,    parser.getToken());
+    EXPECT_EQ(ParserToken::Key,         parser.getToken());
+    EXPECT_EQ("Key",                    parser.getKey());
+    EXPECT_EQ(ParserToken::ArrayStart,  parser.getToken());
+    EXPECT_EQ(ParserToken::Value,       parser.getToken());
+    int     value1;
+    parser.getValue(value1);
+    EXPECT_EQ(1, value1);
+    EXPECT_EQ(ParserToken::Value,       parser.getToken());
+    double  value2;
+    parser.getValue(value2);
+    EXPECT_EQ(2.5, value2);
+    EXPECT_EQ(ParserToken::Value,       parser.getToken());
+    std::string value3;
+    parser.getValue(value3);
+    EXPECT_EQ("Three", value3);
+    EXPECT_EQ(ParserToken::ArrayEnd,    parser.getToken());
+    EXPECT_EQ(ParserToken::MapEnd,      parser.getToken());
+    EXPECT_EQ(ParserToken::DocEnd,      parser.getToken());
+}
+TEST(JsonFastLexerTest, InPlaceTokens)
+{
+    std::string         input(R"( [ "Test", 456, 789.123, true ] )");
+    JsonFastLexer       lexer(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ('[',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_STRING,  lexer.yylex());
+    // Tokens are not copied. They point directly into the input.
+    EXPECT_EQ(input.data() + 3,                    lexer.YYText());
+    EXPECT_EQ(',',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_EQ(',',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_FLOAT,   lexer.yylex());
+    EXPECT_EQ(',',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_TRUE,    lexer.yylex());
+    EXPECT_EQ(']',                                 lexer.yylex());
+    EXPECT_EQ(0,                                   lexer.yylex());
+}
+TEST(JsonFastLexerTest, InPlaceNumberAtEndOfMemory)
+{
+    // The number is not followed by a terminator in the input.
+    char const          input[] = {'1', '2', '3', '4', '5', '6'};
+    ThorsAnvil::Serialize::JsonParser parser(input, 5);
+    int                 value = 0;
+
+    ThorsAnvil::Serialize::DeSerializer deSerializer(parser);
+    deSerializer.parse(value);
+    EXPECT_EQ(12345, value);
+}
+TEST(JsonFastLexerTest, InPlaceLongWhiteSpace)
+{
+    std::string         input = std::string(1000, ' ') + "\"" + std::string(1000, 'x') + "\"" + std::string(1000, '\n');
+    JsonFastLexer       lexer(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_STRING,  lexer.yylex());
+    EXPECT_EQ(1002,                                lexer.YYLeng());
+    EXPECT_EQ(0,                                   lexer.yylex());
+}
+TEST(JsonFastLexerTest, TwoDocumentsOnStreamThatCanNotSeek)
+{
+    // A stream buffer like a pipe: the data can be read but not seeked.
+    struct PipeBuffer: std::streambuf
+    {
+        PipeBuffer(std::string& data) {setg(&data[0], &data[0], &data[0] + data.size());}
+    };
+    std::string         input("[1, 2] {\"Key\": 3}");
+    PipeBuffer          pipe(input);
+    std::istream        stream(&pipe);
+
+    std::vector<int>            first;
+    std::map<std::string, int>  second;
+    {
+        ThorsAnvil::Serialize::JsonParser   parser(stream, ThorsAnvil::Serialize::ParserInterface::ParseType::Weak, ThorsAnvil::Serialize::JsonParser::LexerType::Fast);
+        ThorsAnvil::Serialize::DeSerializer deSerializer(parser);
+        deSerializer.parse(first);
+    }
+    {
+        // The first parser must not have consumed the second document.
+        ThorsAnvil::Serialize::JsonParser   parser(stream, ThorsAnvil::Serialize::ParserInterface::ParseType::Weak, ThorsAnvil::Serialize::JsonParser::LexerType::Fast);
+        ThorsAnvil::Serialize::DeSerializer deSerializer(parser);
+        deSerializer.parse(second);
+    }
+    EXPECT_EQ(std::vector<int>({1, 2}), first);
+    EXPECT_EQ(3,                        second["Key"]);
+}
@@ -0,0 +1,101 @@
+
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace TA=ThorsAnvil::Serialize;
+
+namespace JsonForEachTest
+{
+    struct Element
+    {
+        int     id      = 0;
+        int     retries = 3;
+    };
+}
+ThorsAnvil_MakeTrait(JsonForEachTest::Element, id, retries);
+
+TEST(JsonForEachTest, EachElementOfStream)
+{
+    std::stringstream   stream("[1, 2, 3, 4]");
+    std::vector<int>    result;
+
+    TA::jsonForEach<int>(stream, [&result](int&& value){result.push_back(value);});
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), result);
+}
+TEST(JsonForEachTest, EachElementOfMemory)
+{
+    std::string         input(R"([{"A": true}, {"B": false, "C": true}, {}])");
+    std::vector<std::size_t>    sizes;
+
+    TA::jsonForEach<std::map<std::string, bool>>(std::string_view(input), [&sizes](std::map<std::string, bool>&& value)
+    {
+        sizes.push_back(value.size());
+    });
+    // The object is reset between elements.
+    EXPECT_EQ(std::vector<std::size_t>({1, 2, 0}), sizes);
+}
+TEST(JsonForEachTest, ObjectMemoryIsReused)
+{
+    std::string                     input("[[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20], [1], [2, 3]]");
+    std::vector<std::vector<int>>   result;
+    std::vector<std::size_t>        capacity;
+
+    TA::jsonForEach<std::vector<int>>(std::string_view(input), [&result, &capacity](std::vector<int>&& value)
+    {
+        // Copy (not move) so the object keeps its memory for the next element.
+        result.push_back(value);
+        capacity.push_back(value.capacity());
+    }, TA::ParserInterface::ParseType::Weak, true);
+    EXPECT_EQ(std::vector<std::vector<int>>({{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20}, {1}, {2, 3}}), result);
+    ASSERT_EQ(3,    capacity.size());
+    EXPECT_LE(20,   capacity[1]);
+    EXPECT_LE(20,   capacity[2]);
+}
+TEST(JsonForEachTest, ElementsStartFromDefault)
+{
+    std::string                 input(R"([{"id": 1}, {"id": 2, "retries": 5}, {"id": 3}])");
+    std::vector<int>            retries;
+    std::vector<int>            reparsed;
+
+    TA::jsonForEach<JsonForEachTest::Element>(std::string_view(input), [&retries](JsonForEachTest::Element&& value){retries.push_back(value.retries);});
+    TA::jsonForEach<JsonForEachTest::Element>(std::string_view(input), [&reparsed](JsonForEachTest::Element&& value){reparsed.push_back(value.retries);}, TA::ParserInterface::ParseType::Weak, true);
+    // Same values as jsonImport() of the array.
+    EXPECT_EQ(std::vector<int>({3, 5, 3}), retries);
+    // resetObject() makes a missing member V{}.
+    EXPECT_EQ(std::vector<int>({0, 5, 0}), reparsed);
+}
+TEST(JsonForEachTest, ManyElements)
+{
+    std::stringstream   stream;
+    stream << "[";
+    for (int loop = 0; loop < 100000; ++loop)
+    {
+        stream << (loop == 0 ? "" : ",") << loop;
+    }
+    stream << "]";
+    long long           total   = 0;
+    int                 count   = 0;
+
+    TA::jsonForEach<int>(stream, [&](int&& value){total += value; ++count;});
+    EXPECT_EQ(100000,               count);
+    EXPECT_EQ(4999950000LL,         total);
+}
+TEST(JsonForEachTest, EmptyArray)
+{
+    std::stringstream   stream("[]");
+    int                 count   = 0;
+
+    TA::jsonForEach<int>(stream, [&count](int&&){++count;});
+    EXPECT_EQ(0, count);
+}
+TEST(JsonForEachTest, NotAnArray)
+{
+    std::stringstream   stream(R"({"A": 1})");
+
+    EXPECT_THROW(TA::jsonForEach<int>(stream, [](int&&){}), std::runtime_error);
+}
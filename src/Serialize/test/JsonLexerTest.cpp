@@ -34,4 +34,13 @@ TEST(JsonLexerTest, ValueTokens)
     EXPECT_EQ(ThorsAnvil::Serialize::JSON_FALSE,   lexer.yylex());
     EXPECT_EQ(ThorsAnvil::Serialize::JSON_NULL,    lexer.yylex());
 }
+TEST(JsonLexerTest, WhiteSpace)
+{
+    std::stringstream   stream("[ \t\r\n1\r\n]");
+    JsonLexerFlexLexer  lexer(&stream);
+
+    EXPECT_EQ('[',                                 lexer.yylex());
+    EXPECT_EQ(ThorsAnvil::Serialize::JSON_INTEGER, lexer.yylex());
+    EXPECT_EQ(']',                                 lexer.yylex());
+}
 
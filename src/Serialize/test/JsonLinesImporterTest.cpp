@@ -0,0 +1,113 @@
+
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include "JsonLinesImporterTest.h"
+#include <sstream>
+#include <vector>
+#include <map>
+#include <new>
+
+namespace TA=ThorsAnvil::Serialize;
+
+TEST(JsonLinesImporterTest, OneValuePerLine)
+{
+    std::stringstream               stream("[1,2]\n[3]\n\n[]\n[4,5,6]");
+    std::vector<std::vector<int>>   result;
+
+    for (auto& value: TA::jsonLinesImport<std::vector<int>>(stream))
+    {
+        result.push_back(std::move(value));
+    }
+    ASSERT_EQ(4, result.size());
+    EXPECT_EQ(std::vector<int>({1, 2}),     result[0]);
+    EXPECT_EQ(std::vector<int>({3}),        result[1]);
+    EXPECT_EQ(std::vector<int>({}),         result[2]);
+    EXPECT_EQ(std::vector<int>({4, 5, 6}),  result[3]);
+}
+TEST(JsonLinesImporterTest, ValueIsResetForEachLine)
+{
+    std::stringstream                   stream("{\"A\": true}\r\n{\"B\": false}\r\n");
+    auto                                importer = TA::jsonLinesImport<std::map<std::string, bool>>(stream);
+    auto                                loop     = importer.begin();
+
+    ASSERT_NE(importer.end(),   loop);
+    EXPECT_EQ(1,                loop->size());
+    EXPECT_TRUE((*loop)["A"]);
+    ++loop;
+    ASSERT_NE(importer.end(),   loop);
+    EXPECT_EQ(1,                loop->size());
+    EXPECT_FALSE((*loop)["B"]);
+    ++loop;
+    EXPECT_EQ(importer.end(),   loop);
+    EXPECT_EQ(2,                importer.lines());
+}
+TEST(JsonLinesImporterTest, BadLineThrows)
+{
+    std::stringstream               stream("[1]\n[2,\n[3]\n");
+    auto                            importer = TA::jsonLinesImport<std::vector<int>>(stream);
+    auto                            loop     = importer.begin();
+
+    EXPECT_EQ(std::vector<int>({1}),    *loop);
+    EXPECT_THROW(++loop,                std::runtime_error);
+}
+TEST(JsonLinesImporterTest, BadLineSkipped)
+{
+    using Importer = TA::JsonLinesImporter<std::vector<int>>;
+    std::stringstream               stream("[1]\n[2,\n{\"x\": 1}\n[3]\n");
+    Importer                        importer(stream, TA::ParserInterface::ParseType::Weak, Importer::BadLine::Skip);
+    std::vector<int>                result;
+
+    for (auto& value: importer)
+    {
+        result.insert(result.end(), value.begin(), value.end());
+    }
+    EXPECT_EQ(std::vector<int>({1, 3}), result);
+    EXPECT_EQ(4,                        importer.lines());
+    EXPECT_EQ(2,                        importer.badLines());
+}
+TEST(JsonLinesImporterTest, DataAfterTheDocumentIsABadLine)
+{
+    using Importer = TA::JsonLinesImporter<std::vector<int>>;
+    std::stringstream               stream("[1]  \n[2] garbage\n[3][4]\n[5]\t\n");
+    Importer                        importer(stream, TA::ParserInterface::ParseType::Weak, Importer::BadLine::Skip);
+    std::vector<int>                result;
+
+    for (auto& value: importer)
+    {
+        result.insert(result.end(), value.begin(), value.end());
+    }
+    EXPECT_EQ(std::vector<int>({1, 5}), result);
+    EXPECT_EQ(4,                        importer.lines());
+    EXPECT_EQ(2,                        importer.badLines());
+}
+TEST(JsonLinesImporterTest, OnlyParseErrorsAreSkipped)
+{
+    using Importer = TA::JsonLinesImporter<JsonLinesImporterTest::OneMember>;
+    std::stringstream               stream("{\"A\": 1}\n{\"OutOfMemory\": 2}\n{\"A\": 3}\n");
+    Importer                        importer(stream, TA::ParserInterface::ParseType::Weak, Importer::BadLine::Skip);
+    auto                            loop     = importer.begin();
+
+    EXPECT_EQ(1,                        loop->value);
+    EXPECT_THROW(++loop,                std::bad_alloc);
+    EXPECT_EQ(0,                        importer.badLines());
+}
+TEST(JsonLinesImporterTest, LinesStartFromDefault)
+{
+    using Importer = TA::JsonLinesImporter<std::vector<int>>;
+    std::stringstream               stream("[1,2,3,4,5,6,7,8,9,10]\n[1]\n");
+    Importer                        importer(stream);
+    std::stringstream               reparseStream("[1,2,3,4,5,6,7,8,9,10]\n[1]\n");
+    Importer                        reparse(reparseStream, TA::ParserInterface::ParseType::Weak, Importer::BadLine::Throw, true);
+
+    auto loop = importer.begin();
+    ++loop;
+    EXPECT_EQ(std::vector<int>({1}),    *loop);
+    EXPECT_GT(10,                       loop->capacity());
+
+    // With reparse the vector keeps its memory between lines.
+    auto reparseLoop = reparse.begin();
+    ++reparseLoop;
+    EXPECT_EQ(std::vector<int>({1}),    *reparseLoop);
+    EXPECT_LE(10,                       reparseLoop->capacity());
+}
@@ -0,0 +1,52 @@
+#ifndef THORS_ANVIL_SERIALIZE_TEST_JSON_LINES_IMPORTER_TEST_H
+#define THORS_ANVIL_SERIALIZE_TEST_JSON_LINES_IMPORTER_TEST_H
+
+#include "../Serialize.h"
+#include "../SerUtil.h"
+#include <new>
+#include <string_view>
+
+namespace JsonLinesImporterTest
+{
+    // A Json object with one member; the key "OutOfMemory" throws std::bad_alloc.
+    struct OneMember
+    {
+        int     value = 0;
+    };
+}
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+template<>
+class Traits<JsonLinesImporterTest::OneMember>
+{
+    public:
+        static constexpr TraitType type = TraitType::Map;
+
+        class MemberExtractor
+        {
+            public:
+                constexpr MemberExtractor(){}
+                template<typename Parser>
+                void operator()(Parser& parser, std::string_view const& key, JsonLinesImporterTest::OneMember& object) const
+                {
+                    if (key == "OutOfMemory")
+                    {
+                        throw std::bad_alloc();
+                    }
+                    GetValueType<int>   valueGetter(parser, object.value);
+                }
+        };
+
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+    }
+}
+
+#endif
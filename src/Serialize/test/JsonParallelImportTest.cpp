@@ -0,0 +1,224 @@
+
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "JsonParallelImport.h"
+#include "SerUtil.h"
+#include "JsonLinesImporterTest.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <new>
+
+namespace TA=ThorsAnvil::Serialize;
+
+namespace ParallelImportTest
+{
+    struct Kid
+    {
+        int                 id      = 0;
+    };
+    struct Element
+    {
+        int                 id      = 0;
+        int                 retries = 3;
+        std::vector<Kid>    kids;
+    };
+}
+ThorsAnvil_MakeTrait(ParallelImportTest::Kid, id);
+ThorsAnvil_MakeTrait(ParallelImportTest::Element, id, retries, kids);
+
+TEST(JsonParallelImportTest, SplitOnLineBoundaries)
+{
+    std::string                     data("[1]\n[2]\n[3]\n[4]\n[5]");
+    auto                            pieces = TA::jsonSplitLines(data, 3);
+
+    ASSERT_EQ(3,            pieces.size());
+    EXPECT_EQ("[1]\n[2]\n", pieces[0]);
+    EXPECT_EQ("[3]\n[4]\n", pieces[1]);
+    EXPECT_EQ("[5]",        pieces[2]);
+}
+TEST(JsonParallelImportTest, ResultInOrder)
+{
+    std::string                     data;
+    for (int loop = 0; loop < 10000; ++loop)
+    {
+        data += "[" + std::to_string(loop) + ", " + std::to_string(loop * 2) + "]\n";
+    }
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_EQ(0, TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Throw, 4));
+    ASSERT_EQ(10000, result.size());
+    for (int loop = 0; loop < 10000; ++loop)
+    {
+        EXPECT_EQ(std::vector<int>({loop, loop * 2}), result[loop]);
+    }
+}
+TEST(JsonParallelImportTest, MoreThreadsThanLines)
+{
+    std::string                     data("[1]\n\n[2]\n");
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_EQ(0, TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Throw, 16));
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(std::vector<int>({1}), result[0]);
+    EXPECT_EQ(std::vector<int>({2}), result[1]);
+}
+TEST(JsonParallelImportTest, BadLinesSkipped)
+{
+    std::string                     data("[1]\n[2\n[3]\n{}\n[5]\n");
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_EQ(2, TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Skip, 2));
+    ASSERT_EQ(3, result.size());
+    EXPECT_EQ(std::vector<int>({5}), result[2]);
+}
+TEST(JsonParallelImportTest, BadLineReportsLineNumber)
+{
+    std::string                     data("[1]\n[2]\n[3]\n[4\n[5]\n");
+    std::vector<std::vector<int>>   result;
+
+    try
+    {
+        TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Throw, 3);
+        FAIL() << "Expected exception";
+    }
+    catch (std::runtime_error const& e)
+    {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("Line 4:"));
+    }
+    EXPECT_EQ(0, result.size());
+}
+TEST(JsonParallelImportTest, ArrayElementsInOrder)
+{
+    std::string                     data(" [");
+    for (int loop = 0; loop < 10000; ++loop)
+    {
+        data += (loop == 0 ? "" : ",\n") + std::string("[") + std::to_string(loop) + "]";
+    }
+    data += "] ";
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_TRUE(TA::jsonImportArrayParallel(data, result, TA::ParserInterface::ParseType::Weak, 4));
+    ASSERT_EQ(10000, result.size());
+    for (int loop = 0; loop < 10000; ++loop)
+    {
+        EXPECT_EQ(std::vector<int>({loop}), result[loop]);
+    }
+}
+TEST(JsonParallelImportTest, ArrayOfObjects)
+{
+    std::string                                 data(R"([{"A": true}, {"B": false}, {"C": true}, {"D": false}])");
+    std::vector<std::map<std::string, bool>>    result;
+
+    EXPECT_TRUE(TA::jsonImportArrayParallel(data, result, TA::ParserInterface::ParseType::Weak, 4));
+    ASSERT_EQ(4, result.size());
+    EXPECT_TRUE(result[0]["A"]);
+    EXPECT_FALSE(result[3]["D"]);
+}
+TEST(JsonParallelImportTest, ArrayNotSplitInsideStrings)
+{
+    std::string                                 data(R"([{"},{": true, "\"], [": false}, {"B": true}])");
+    std::vector<std::map<std::string, bool>>    result;
+
+    EXPECT_TRUE(TA::jsonImportArrayParallel(data, result, TA::ParserInterface::ParseType::Weak, 8));
+    ASSERT_EQ(2, result.size());
+    EXPECT_TRUE(result[0]["},{"]);
+    EXPECT_FALSE(result[0]["\"], ["]);
+    EXPECT_TRUE(result[1]["B"]);
+}
+TEST(JsonParallelImportTest, ArrayNotSplitInsideNestedElements)
+{
+    std::string                                 data("[");
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        data += (loop == 0 ? "" : ",") + std::string(R"({"id":)") + std::to_string(loop) + R"(,"kids":[{"id":1},{"id":2}]})";
+    }
+    data += "]";
+    std::vector<ParallelImportTest::Element>    result;
+
+    EXPECT_TRUE(TA::jsonImportArrayParallel(data, result, TA::ParserInterface::ParseType::Weak, 8));
+    ASSERT_EQ(100, result.size());
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        EXPECT_EQ(loop, result[loop].id);
+        ASSERT_EQ(2,    result[loop].kids.size());
+        EXPECT_EQ(2,    result[loop].kids[1].id);
+    }
+}
+TEST(JsonParallelImportTest, ArrayElementsStartFromDefault)
+{
+    // A member missing from an element keeps its default member initializer on both paths.
+    std::string                                 data(R"([{"id":1}, {"id":2,"retries":5}, {"id":3}, {"id":4}])");
+    std::vector<ParallelImportTest::Element>    parallel;
+    std::vector<ParallelImportTest::Element>    serial;
+
+    EXPECT_TRUE(TA::jsonImportArrayParallel(data, parallel, TA::ParserInterface::ParseType::Weak, 4));
+    EXPECT_FALSE(TA::jsonImportArrayParallel(data, serial, TA::ParserInterface::ParseType::Weak, 1));
+    ASSERT_EQ(4, parallel.size());
+    ASSERT_EQ(4, serial.size());
+    for (int loop = 0; loop < 4; ++loop)
+    {
+        EXPECT_EQ(loop == 1 ? 5 : 3,    parallel[loop].retries);
+        EXPECT_EQ(serial[loop].retries, parallel[loop].retries);
+    }
+}
+TEST(JsonParallelImportTest, ArrayTrailingComma)
+{
+    std::vector<std::map<std::string, int>>     result;
+
+    EXPECT_THROW(TA::jsonImportArrayParallel(std::string_view(R"([{"A":1},{"A":2},])"), result, TA::ParserInterface::ParseType::Weak, 2), std::runtime_error);
+}
+TEST(JsonParallelImportTest, ArrayEmpty)
+{
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_FALSE(TA::jsonImportArrayParallel(std::string_view("[ ]"), result));
+    EXPECT_EQ(0, result.size());
+}
+TEST(JsonParallelImportTest, ArrayInvalid)
+{
+    std::vector<std::vector<int>>   result;
+
+    EXPECT_THROW(TA::jsonImportArrayParallel(std::string_view("[[1], [2], [x]]"), result, TA::ParserInterface::ParseType::Weak, 3), std::runtime_error);
+}
+TEST(JsonParallelImportTest, WorkersJoinedWhenUnwinding)
+{
+    // The work on the current thread may throw anything; the workers are still joined.
+    std::atomic<int>    done(0);
+
+    EXPECT_THROW(
+        {
+            TA::JsonWorkers workers(2);
+            workers.start([&done](){++done;});
+            throw 1;
+        },
+        int
+    );
+    EXPECT_EQ(1, done);
+}
+TEST(JsonParallelImportTest, OnlyParseErrorsAreSkipped)
+{
+    std::string                                     data("{\"A\": 1}\n{\"A\": 2}\n{\"OutOfMemory\": 3}\n{\"A\": 4}\n");
+    std::vector<JsonLinesImporterTest::OneMember>   result;
+
+    // The failure is on the current thread (1) or a worker thread (2).
+    EXPECT_THROW(TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Skip, 1), std::bad_alloc);
+    EXPECT_THROW(TA::jsonLinesImportParallel(data, result, TA::ParserInterface::ParseType::Weak, TA::JsonBadLine::Skip, 2), std::bad_alloc);
+    EXPECT_EQ(0, result.size());
+}
+TEST(JsonParallelImportTest, ArrayResourceErrorIsNotRetried)
+{
+    std::string                                     data(R"([{"A": 1}, {"A": 2}, {"OutOfMemory": 3}, {"A": 4}])");
+    std::vector<JsonLinesImporterTest::OneMember>   result;
+
+    EXPECT_THROW(TA::jsonImportArrayParallel(data, result, TA::ParserInterface::ParseType::Weak, 2), std::bad_alloc);
+    EXPECT_EQ(0, result.size());
+}
+TEST(JsonParallelImportTest, WorkerExceptionRethrownByFinish)
+{
+    TA::JsonWorkers workers(2);
+    workers.start([](){throw 1;});
+
+    EXPECT_THROW(workers.finish(), int);
+}
@@ -581,3 +581,252 @@ TEST(JsonParserTest, getDataFromBool)
     EXPECT_EQ(false, value4);
 }
 
+TEST(JsonParserTest, getDataOutOfRange)
+{
+    std::stringstream   stream(R"([70000, -1, 1e400])");
+    TA::JsonParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    short           value1;
+    ASSERT_ANY_THROW(
+        parser.getValue(value1)
+    );
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    unsigned int    value2;
+    ASSERT_ANY_THROW(
+        parser.getValue(value2)
+    );
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    double          value3;
+    ASSERT_ANY_THROW(
+        parser.getValue(value3)
+    );
+}
+TEST(JsonParserTest, getKeyAndValueView)
+{
+    std::string         input(R"({"Key": "Value", "Esc\naped": "Tab\there"})");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    std::string_view    key1 = parser.getKeyView();
+    EXPECT_EQ("Key",                                    key1);
+    // No escape characters: the view refers directly to the input.
+    EXPECT_EQ(input.data() + 2,                         key1.data());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ("Value",                                  parser.getValueView());
+
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("Esc\naped",                              parser.getKeyView());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ("Tab\there",                              parser.getValueView());
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+}
+TEST(JsonParserTest, EveryTokenThroughTheTokenTable)
+{
+    std::stringstream   stream(R"([{"A": true, "B": false, "C": null, "D": "S", "E": 12, "F": 1.5}, [], {}])");
+    TA::JsonParser      parser(stream, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    for (char const* key: {"A", "B", "C", "D", "E", "F"})
+    {
+        EXPECT_EQ(ParserInterface::ParserToken::Key,    parser.getToken());
+        EXPECT_EQ(key,                                  parser.getKey());
+        EXPECT_EQ(ParserInterface::ParserToken::Value,  parser.getToken());
+    }
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(JsonParserTest, ManySeparatorsInOneContainer)
+{
+    // Colons and commas are consumed in a loop (not by recursion).
+    std::string         input("[");
+    for (int loop = 0; loop < 100000; ++loop)
+    {
+        input += R"({"K":1},)";
+    }
+    input += "{}]";
+    std::stringstream   stream(input);
+    TA::JsonParser      parser(stream, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+
+    std::size_t         count   = 0;
+    for (ParserInterface::ParserToken token = parser.getToken(); token != ParserInterface::ParserToken::DocEnd; token = parser.getToken())
+    {
+        ASSERT_NE(ParserInterface::ParserToken::Error, token);
+        ++count;
+    }
+    // DocStart + ArrayStart + 100000 * (MapStart + Key + Value + MapEnd) + MapStart + MapEnd + ArrayEnd
+    EXPECT_EQ(2 + 100000 * 4 + 3,                       count);
+}
+TEST(JsonParserTest, TokenOutOfPlace)
+{
+    std::stringstream   missingComma("[1 2]");
+    TA::JsonParser      parser1(missingComma, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser1.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser1.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser1.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Error,      parser1.getToken());
+
+    std::stringstream   missingColon(R"({"A" 1})");
+    TA::JsonParser      parser2(missingColon, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser2.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser2.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser2.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Error,      parser2.getToken());
+
+    std::stringstream   trailingComma("[1,]");
+    TA::JsonParser      parser3(trailingComma, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Flex);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser3.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser3.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser3.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Error,      parser3.getToken());
+}
+TEST(JsonParserTest, SkipValueInMap)
+{
+    std::string         input(R"({"Skip": {"A": [1, {"B": "]}"}], "C": "\"{"}, "Keep": 5, "Last": [[]]})");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("Skip",                                   parser.getKey());
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("Keep",                                   parser.getKey());
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("Last",                                   parser.getKey());
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(JsonParserTest, SkipValueInArray)
+{
+    std::string         input(R"([{"A": 1}, 2, [3, 4]])");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+    int                 value = 0;
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(2,                                        value);
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::DocEnd,     parser.getToken());
+}
+TEST(JsonParserTest, SkipValueAcrossBlocks)
+{
+    // The skipped value is larger than the block read from the stream.
+    std::string         skipped = "[" + std::string(TA::JsonFastLexer::BlockSize, ' ') + "\"" + std::string(TA::JsonFastLexer::BlockSize, '[') + "\"]";
+    std::stringstream   stream(R"({"Skip": )" + skipped + R"(, "Keep": 7})");
+    TA::JsonParser      parser(stream, ParserInterface::ParseType::Weak, TA::JsonParser::LexerType::Fast);
+    int                 value = 0;
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    parser.getValue(value);
+    EXPECT_EQ(7,                                        value);
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+}
+TEST(JsonParserTest, SkipValueUnterminated)
+{
+    std::string         input(R"({"Skip": [1, 2)");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_THROW(parser.ignoreValue(), std::runtime_error);
+}
+TEST(JsonParserTest, SkipValueStrict)
+{
+    std::string         input(R"({"Skip": 1})");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()), ParserInterface::ParseType::Strict);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_THROW(parser.ignoreValue(), std::runtime_error);
+}
+TEST(JsonParserTest, TryGetValue)
+{
+    std::string         input(R"({"Int": 12, "List": ["Text", true]})");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+    int                 value   = 0;
+    std::string         text;
+    bool                flag    = false;
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_TRUE(parser.tryGetValue(value));
+    EXPECT_EQ(12,                                       value);
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    // Not a value: the token is pushed back.
+    EXPECT_FALSE(parser.tryGetValue(value));
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_TRUE(parser.tryGetValue(text));
+    EXPECT_EQ("Text",                                   text);
+    EXPECT_TRUE(parser.tryGetValue(flag));
+    EXPECT_TRUE(flag);
+    EXPECT_FALSE(parser.tryGetValue(flag));
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapEnd,     parser.getToken());
+}
+TEST(JsonParserTest, SizeHint)
+{
+    std::string         input(R"([1, [2, 3], {"A": "x,]", "B": "\"]"}, "[", 5])");
+    TA::JsonParser      parser(std::string_view(input.data(), input.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    // Nested values and commas or brackets inside strings are not counted.
+    EXPECT_EQ(5,                                        parser.getSizeHint());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    // Only available directly after the map/array is opened.
+    EXPECT_EQ(0,                                        parser.getSizeHint());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_EQ(2,                                        parser.getSizeHint());
+    parser.ignoreValue();
+    parser.ignoreValue();
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(2,                                        parser.getSizeHint());
+}
+TEST(JsonParserTest, SizeHintEmptyAndUnterminated)
+{
+    std::string         empty("[ ]");
+    TA::JsonParser      emptyParser(std::string_view(empty.data(), empty.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   emptyParser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, emptyParser.getToken());
+    EXPECT_EQ(0,                                        emptyParser.getSizeHint());
+
+    // The end of the array is not in the data: the size is unknown.
+    std::string         partial("[1, 2, 3");
+    TA::JsonParser      partialParser(std::string_view(partial.data(), partial.size()));
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   partialParser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, partialParser.getToken());
+    EXPECT_EQ(0,                                        partialParser.getSizeHint());
+}
@@ -249,3 +249,68 @@ TEST(JsonPrinterTest, PuttingKeyInArray)
     );
 }
 
+TEST(JsonPrinterTest, NumbersRoundTrip)
+{
+    std::stringstream                   stream;
+    ThorsAnvil::Serialize::JsonPrinter  printer(stream, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+
+    printer.openDoc();
+    printer.openArray(-1);
+    printer.addValue(0.1 + 0.2);
+    printer.addValue(123456789.0);
+    printer.addValue(1.5f);
+    printer.addValue(-1234567890123LL);
+    printer.addValue(18446744073709551615ULL);
+    printer.closeArray();
+    printer.closeDoc();
+
+    EXPECT_EQ("[0.30000000000000004,123456789,1.5,-1234567890123,18446744073709551615]", stream.str());
+}
+TEST(JsonPrinterTest, OutputLargerThanBuffer)
+{
+    std::stringstream                   stream;
+    ThorsAnvil::Serialize::JsonPrinter  printer(stream, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+    std::string                         longString(ThorsAnvil::Serialize::JsonOutputBuffer::BlockSize + 10, 'x');
+    std::string                         expected = "[";
+
+    printer.openDoc();
+    printer.openArray(-1);
+    for (int loop = 0; loop < 20000; ++loop)
+    {
+        printer.addValue(loop);
+        expected += std::to_string(loop) + ",";
+    }
+    printer.addValue(longString);
+    expected += "\"" + longString + "\"]";
+    printer.closeArray();
+    // The top level value is complete so everything is on the stream before closeDoc()
+    EXPECT_EQ(expected, stream.str());
+    printer.closeDoc();
+}
+TEST(JsonPrinterTest, DestructorDoesNotThrowOnStreamError)
+{
+    // A stream buffer with no space: every write fails.
+    struct RejectOutput: std::streambuf {};
+    RejectOutput                        reject;
+    std::ostream                        stream(&reject);
+    stream.exceptions(std::ios_base::badbit);
+
+    {
+        ThorsAnvil::Serialize::JsonPrinter  printer(stream);
+        printer.openDoc();
+        printer.openArray(-1);
+        printer.addValue(1);
+        // The array is not complete so the output is still buffered
+        // and is written (and fails) when the printer is destroyed.
+    }
+    EXPECT_TRUE(stream.bad());
+
+    stream.clear();
+    ThorsAnvil::Serialize::JsonPrinter  printer(stream);
+    printer.openDoc();
+    printer.openArray(-1);
+    printer.addValue(1);
+    // Errors are reported when the output is flushed explicitly.
+    EXPECT_THROW(printer.closeArray(), std::ios_base::failure);
+    stream.exceptions(std::ios_base::goodbit);
+}
@@ -0,0 +1,98 @@
+#include "SerializeConfig.h"
+
+#include "gtest/gtest.h"
+#include "test/BinaryParserTest.h"
+#include "MappedFile.h"
+#include "BinaryThor.h"
+#include "JsonThor.h"
+#include "YamlThor.h"
+#include <fstream>
+#include <cstdio>
+
+namespace TA=ThorsAnvil::Serialize;
+
+namespace
+{
+    class TestFile
+    {
+        std::string     path;
+        public:
+            TestFile(std::string const& path, std::string const& content)
+                : path(path)
+            {
+                std::ofstream   file(path, std::ios::binary);
+                file << content;
+            }
+            ~TestFile()
+            {
+                std::remove(path.c_str());
+            }
+            std::string const& name() const {return path;}
+    };
+}
+
+TEST(MappedFileTest, MapFileContent)
+{
+    TestFile            file("MappedFileTest.txt", "Some text\nin a file");
+    TA::MappedFile      mapped(file.name());
+
+    EXPECT_EQ("Some text\nin a file", mapped.data());
+}
+TEST(MappedFileTest, MapEmptyFile)
+{
+    TestFile            file("MappedFileTest.txt", "");
+    TA::MappedFile      mapped(file.name());
+
+    EXPECT_EQ(0, mapped.data().size());
+}
+TEST(MappedFileTest, MapMissingFile)
+{
+    EXPECT_THROW(TA::MappedFile("MappedFileTest.NotThere"), std::runtime_error);
+}
+TEST(MappedFileTest, MemoryStreamBufRead)
+{
+    std::string_view    data("12 Plop");
+    TA::MemoryStreamBuf buffer(data);
+    std::istream        stream(&buffer);
+    int                 value;
+    std::string         word;
+
+    stream >> value >> word;
+    EXPECT_EQ(12, value);
+    EXPECT_EQ("Plop", word);
+}
+TEST(MappedFileTest, JsonImportFile)
+{
+    TestFile            file("MappedFileTest.json", R"({"ace": 10, "val": 1024})");
+    Base                base{0, 0};
+
+    TA::jsonImportFile(file.name(), base);
+    EXPECT_EQ(10,   base.ace);
+    EXPECT_EQ(1024, base.val);
+}
+#ifdef HAVE_YAML
+TEST(MappedFileTest, YamlImportFile)
+{
+    TestFile            file("MappedFileTest.yaml", "---\nace: 10\nval: 1024\n...\n");
+    Base                base{0, 0};
+
+    TA::yamlImportFile(file.name(), base);
+    EXPECT_EQ(10,   base.ace);
+    EXPECT_EQ(1024, base.val);
+}
+#endif
+#ifdef NETWORK_BYTE_ORDER
+TEST(MappedFileTest, BinImportFile)
+{
+    Base                base{10, 1024};
+    std::stringstream   stream;
+    stream << TA::binExport(base);
+
+    TestFile            file("MappedFileTest.bin", stream.str());
+    Base                base2{0, 0};
+
+    TA::binImportFile(file.name(), base2);
+    EXPECT_EQ(10,   base2.ace);
+    EXPECT_EQ(1024, base2.val);
+}
+#endif
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <array>
+#include <tuple>
+
+namespace ReparseTest
+{
+    enum Colour {Red, Green, Blue};
+    struct Header
+    {
+        int                         id;
+        std::string                 name;
+        std::vector<std::string>    tags;
+    };
+    struct Message
+    {
+        Header                                  header;
+        std::vector<int>                        values;
+        std::map<std::string, int>              counts;
+        std::unordered_map<std::string, double> weights;
+        std::array<int, 3>                      fixed;
+        std::tuple<int, std::string>            pair;
+        Colour                                  colour;
+    };
+    struct TimedMessage: public Message
+    {
+        long                                    time;
+        std::vector<int>                        extra;
+    };
+}
+
+ThorsAnvil_MakeEnum(ReparseTest::Colour, Red, Green, Blue);
+ThorsAnvil_MakeTrait(ReparseTest::Header, id, name, tags);
+ThorsAnvil_MakeTrait(ReparseTest::Message, header, values, counts, weights, fixed, pair, colour);
+ThorsAnvil_ExpandTrait(ReparseTest::Message, ReparseTest::TimedMessage, time, extra);
+
+using namespace ThorsAnvil::Serialize;
+
+TEST(ReparseTest, ResetObject)
+{
+    ReparseTest::TimedMessage   message;
+    message.header.id       = 5;
+    message.header.name     = "A name that is longer than the small string buffer";
+    message.header.tags     = {"One", "Two"};
+    message.values          = {1, 2, 3, 4};
+    message.counts          = {{"A", 1}};
+    message.weights         = {{"B", 2.5}};
+    message.fixed           = {7, 8, 9};
+    message.pair            = std::make_tuple(3, "Three");
+    message.colour          = ReparseTest::Blue;
+    message.time            = 12;
+    message.extra           = {5};
+
+    std::size_t     nameCapacity    = message.header.name.capacity();
+    std::size_t     valuesCapacity  = message.values.capacity();
+
+    resetObject(message);
+
+    EXPECT_EQ(0,                        message.header.id);
+    EXPECT_EQ("",                       message.header.name);
+    EXPECT_EQ(nameCapacity,             message.header.name.capacity());
+    EXPECT_TRUE(message.header.tags.empty());
+    EXPECT_TRUE(message.values.empty());
+    EXPECT_EQ(valuesCapacity,           message.values.capacity());
+    EXPECT_TRUE(message.counts.empty());
+    EXPECT_TRUE(message.weights.empty());
+    EXPECT_EQ((std::array<int, 3>{0, 0, 0}), message.fixed);
+    EXPECT_EQ(0,                        std::get<0>(message.pair));
+    EXPECT_EQ("",                       std::get<1>(message.pair));
+    EXPECT_EQ(ReparseTest::Red,         message.colour);
+    EXPECT_EQ(0,                        message.time);
+    EXPECT_TRUE(message.extra.empty());
+}
+
+TEST(ReparseTest, ImportAppendsReparseReplaces)
+{
+    std::string const   first(R"({"header": {"id": 1, "name": "First", "tags": ["X"]}, "values": [1, 2, 3], "counts": {"A": 1}, "colour": "Green", "time": 10, "extra": [4]})");
+    std::string const   second(R"({"header": {"name": "Second"}, "values": [9], "time": 20})");
+
+    ReparseTest::TimedMessage   message;
+    jsonReparse(first, message);
+    EXPECT_EQ(1,                                message.header.id);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}),      message.values);
+
+    // jsonImport() adds to what is there.
+    jsonImport(second, message);
+    EXPECT_EQ(1,                                message.header.id);
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 9}),   message.values);
+
+    // jsonReparse() replaces it: members that are not in the input are empty.
+    std::istringstream  stream(second);
+    stream >> jsonReparse(message);
+    EXPECT_EQ(0,                                message.header.id);
+    EXPECT_EQ("Second",                         message.header.name);
+    EXPECT_TRUE(message.header.tags.empty());
+    EXPECT_EQ(std::vector<int>({9}),            message.values);
+    EXPECT_TRUE(message.counts.empty());
+    EXPECT_EQ(ReparseTest::Red,                 message.colour);
+    EXPECT_EQ(20,                               message.time);
+    EXPECT_TRUE(message.extra.empty());
+}
@@ -6,6 +6,53 @@
 
 namespace TS = ThorsAnvil::Serialize;
 
+namespace SerMapTest
+{
+    // A Map type with a member extractor that takes the key as a std::string.
+    struct StringKeyMap
+    {
+        std::map<std::string, int>  data;
+    };
+}
+
+namespace ThorsAnvil
+{
+    namespace Serialize
+    {
+template<>
+class Traits<SerMapTest::StringKeyMap>
+{
+    public:
+        static constexpr TraitType type = TraitType::Map;
+
+        class MemberExtractor
+        {
+            public:
+                constexpr MemberExtractor(){}
+                void operator()(PrinterInterface& printer, SerMapTest::StringKeyMap const& object) const
+                {
+                    PutValueType<int>   valuePutter(printer);
+                    for (auto const& loop: object.data)
+                    {
+                        printer.addKey(loop.first);
+                        valuePutter.putValue(loop.second);
+                    }
+                }
+                void operator()(ParserInterface& parser, std::string const& key, SerMapTest::StringKeyMap& object) const
+                {
+                    GetValueType<int>   valueGetter(parser, object.data[key]);
+                }
+        };
+
+        static MemberExtractor const& getMembers()
+        {
+            static constexpr MemberExtractor    memberExtractor;
+            return memberExtractor;
+        }
+};
+    }
+}
+
 TEST(SerMapTest, serialize)
 {
     std::map<int, double>  data;
@@ -56,3 +103,15 @@ TEST(SerMapTest, deSerializeStringKey)
     EXPECT_EQ(data["OfMiceAndMen"], true);
 }
 
+
+TEST(SerMapTest, deSerializeWithStringKeyExtractor)
+{
+    SerMapTest::StringKeyMap    data;
+
+    std::stringstream       stream(R"({"One":1, "Two":2})");
+    stream >> TS::jsonImport(data);
+
+    EXPECT_EQ(data.data.size(),     2);
+    EXPECT_EQ(data.data["One"],     1);
+    EXPECT_EQ(data.data["Two"],     2);
+}
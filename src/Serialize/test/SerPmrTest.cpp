@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "YamlThor.h"
+#include "SerUtil.h"
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <set>
+#include <array>
+#include <sstream>
+
+namespace SerPmrTest
+{
+    struct Item
+    {
+        std::pmr::string                                            name;
+        std::pmr::vector<double>                                    weights;
+    };
+    struct Request
+    {
+        int                                                         id;
+        std::pmr::string                                            path;
+        std::pmr::vector<std::pmr::string>                          tags;
+        std::pmr::map<std::pmr::string, std::pmr::vector<int>>      values;
+        std::pmr::unordered_map<std::pmr::string, std::pmr::string> headers;
+        std::pmr::set<std::pmr::string>                             flags;
+        std::pmr::vector<Item>                                      items;
+        std::array<std::pmr::string, 2>                             pair;
+    };
+}
+
+ThorsAnvil_MakeTrait(SerPmrTest::Item, name, weights);
+ThorsAnvil_MakeTrait(SerPmrTest::Request, id, path, tags, values, headers, flags, items, pair);
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    std::string const   requestInput(R"({"id": 12, "path": "/a/path/that/is/longer/than/the/small/string/buffer",)"
+                                     R"( "tags": ["First tag that does not fit in a small string", "Two"],)"
+                                     R"( "values": {"A key that is longer than the small string buffer": [1, 2, 3], "B": [4]},)"
+                                     R"( "headers": {"Content-Type": "application/json; charset=utf-8 - long enough"},)"
+                                     R"( "flags": ["A flag name that is longer than the small string buffer"],)"
+                                     R"( "items": [{"name": "An item name that is longer than the small buffer", "weights": [1.5, 2.5]}],)"
+                                     R"( "pair": ["Left value that is longer than the small buffer", "Right"]})");
+
+    bool uses(std::pmr::memory_resource* resource, SerPmrTest::Request const& request)
+    {
+        bool result = request.path.get_allocator().resource() == resource
+                   && request.tags.get_allocator().resource() == resource
+                   && request.values.get_allocator().resource() == resource
+                   && request.headers.get_allocator().resource() == resource
+                   && request.flags.get_allocator().resource() == resource
+                   && request.items.get_allocator().resource() == resource
+                   && request.pair[0].get_allocator().resource() == resource;
+        for (auto const& tag: request.tags)
+        {
+            result = result && tag.get_allocator().resource() == resource;
+        }
+        for (auto const& value: request.values)
+        {
+            result = result && value.first.get_allocator().resource() == resource && value.second.get_allocator().resource() == resource;
+        }
+        for (auto const& item: request.items)
+        {
+            result = result && item.name.get_allocator().resource() == resource && item.weights.get_allocator().resource() == resource;
+        }
+        return result;
+    }
+}
+
+TEST(SerPmrTest, PmrString)
+{
+    std::pmr::string    value;
+    jsonImport(std::string_view(R"("A pmr string")"), value);
+    EXPECT_EQ("A pmr string", value);
+
+    std::stringstream   stream;
+    stream << jsonExport(value, PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(R"("A pmr string")", stream.str());
+}
+
+TEST(SerPmrTest, PmrMapUsesStringKeys)
+{
+    std::pmr::map<std::pmr::string, int>    value;
+    jsonImport(std::string_view(R"({"One": 1, "Two": 2})"), value);
+    EXPECT_EQ(2, value.size());
+    EXPECT_EQ(1, value["One"]);
+    EXPECT_EQ(2, value["Two"]);
+
+    std::stringstream   stream;
+    stream << jsonExport(value, PrinterInterface::OutputType::Stream);
+    EXPECT_EQ(R"({"One":1,"Two":2})", stream.str());
+}
+
+TEST(SerPmrTest, RoundTrip)
+{
+    SerPmrTest::Request     request;
+    jsonImport(requestInput, request);
+
+    EXPECT_EQ(12,                                                       request.id);
+    EXPECT_EQ("/a/path/that/is/longer/than/the/small/string/buffer",    request.path);
+    EXPECT_EQ(2,                                                        request.tags.size());
+    EXPECT_EQ((std::pmr::vector<int>{1, 2, 3}),                         request.values["A key that is longer than the small string buffer"]);
+    EXPECT_EQ("application/json; charset=utf-8 - long enough",          request.headers["Content-Type"]);
+    EXPECT_EQ(1,                                                        request.flags.size());
+    ASSERT_EQ(1,                                                        request.items.size());
+    EXPECT_EQ((std::pmr::vector<double>{1.5, 2.5}),                     request.items[0].weights);
+    EXPECT_EQ("Right",                                                  request.pair[1]);
+
+    std::stringstream   json;
+    json << jsonExport(request);
+    SerPmrTest::Request     copy;
+    json >> jsonImport(copy);
+    EXPECT_EQ(request.path,     copy.path);
+    EXPECT_EQ(request.tags,     copy.tags);
+    EXPECT_EQ(request.values,   copy.values);
+    EXPECT_EQ(request.headers,  copy.headers);
+    EXPECT_EQ(request.flags,    copy.flags);
+
+    std::stringstream   yaml;
+    yaml << yamlExport(request);
+    SerPmrTest::Request     yamlCopy;
+    yaml >> yamlImport(yamlCopy);
+    EXPECT_EQ(request.tags,     yamlCopy.tags);
+    EXPECT_EQ(request.values,   yamlCopy.values);
+}
+
+TEST(SerPmrTest, ImportIntoMemoryResource)
+{
+    std::pmr::monotonic_buffer_resource     arena;
+    SerPmrTest::Request                     request;
+    EXPECT_FALSE(uses(&arena, request));
+
+    jsonImport(requestInput, request, &arena);
+
+    EXPECT_TRUE(uses(&arena, request));
+    EXPECT_EQ("An item name that is longer than the small buffer",     request.items[0].name);
+    EXPECT_EQ("Left value that is longer than the small buffer",        request.pair[0]);
+}
+
+TEST(SerPmrTest, StreamImportIntoMemoryResource)
+{
+    std::pmr::monotonic_buffer_resource     arena;
+    SerPmrTest::Request                     request;
+
+    std::istringstream  stream(requestInput);
+    stream >> jsonImport(request, &arena);
+
+    EXPECT_TRUE(uses(&arena, request));
+    EXPECT_EQ(12,   request.id);
+}
+
+TEST(SerPmrTest, UseMemoryResourceKeepsContent)
+{
+    std::pmr::monotonic_buffer_resource     arena;
+    SerPmrTest::Request                     request;
+    jsonImport(requestInput, request);
+
+    useMemoryResource(request, &arena);
+
+    EXPECT_TRUE(uses(&arena, request));
+    EXPECT_EQ("/a/path/that/is/longer/than/the/small/string/buffer",    request.path);
+    EXPECT_EQ(2,                                                        request.tags.size());
+    EXPECT_EQ(1,                                                        request.items.size());
+}
@@ -0,0 +1,90 @@
+#include "SerializeConfig.h"
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "YamlThor.h"
+#include "BinaryThor.h"
+#include "SerRange.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <sstream>
+
+using namespace ThorsAnvil::Serialize;
+
+namespace
+{
+    std::string noSpace(std::string result)
+    {
+        result.erase(std::remove_if(std::begin(result), std::end(result), [](char x){return ::isspace(x);}), std::end(result));
+        return result;
+    }
+    using IntGenerator = std::function<std::optional<int>()>;
+    IntGenerator countTo(int max)
+    {
+        return [max, next = 0]() mutable -> std::optional<int>
+        {
+            return next < max ? std::optional<int>(++next) : std::nullopt;
+        };
+    }
+}
+
+TEST(SerRangeTest, RangeOfVector)
+{
+    std::vector<int>    data{1, 2, 3, 4};
+    std::stringstream   stream;
+
+    stream << jsonExport(serializeRange(data.cbegin(), data.cend()));
+    EXPECT_EQ("[1,2,3,4]", noSpace(stream.str()));
+}
+TEST(SerRangeTest, RangeOfInputIterator)
+{
+    std::stringstream   input("5 6 7");
+    std::stringstream   stream;
+
+    stream << jsonExport(serializeRange(std::istream_iterator<int>(input), std::istream_iterator<int>()));
+    EXPECT_EQ("[5,6,7]", noSpace(stream.str()));
+}
+TEST(SerRangeTest, Generator)
+{
+    std::stringstream   stream;
+
+    stream << jsonExport(serializeGenerator<int>(countTo(3)));
+    EXPECT_EQ("[1,2,3]", noSpace(stream.str()));
+}
+TEST(SerRangeTest, GeneratorYaml)
+{
+    std::stringstream   stream;
+    std::vector<int>    data;
+
+    stream << yamlExport(serializeGenerator<int>(countTo(3)));
+    stream >> yamlImport(data);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), data);
+}
+TEST(SerRangeTest, GeneratorWrongSize)
+{
+    std::stringstream   stream;
+
+    EXPECT_THROW(stream << jsonExport(serializeGenerator<int>(countTo(3), 4)), std::runtime_error);
+}
+#ifdef NETWORK_BYTE_ORDER
+TEST(SerRangeTest, BinaryUnknownSizeIsPatched)
+{
+    std::stringstream   input("5 6 7");
+    std::stringstream   stream;
+    std::vector<int>    data;
+
+    stream << binExport(serializeRange(std::istream_iterator<int>(input), std::istream_iterator<int>()));
+    stream >> binImport(data);
+    EXPECT_EQ(std::vector<int>({5, 6, 7}), data);
+}
+TEST(SerRangeTest, BinarySizeHint)
+{
+    std::stringstream   stream;
+    std::vector<int>    data;
+
+    stream << binExport(serializeGenerator<int>(countTo(4), 4));
+    stream >> binImport(data);
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), data);
+}
+#endif
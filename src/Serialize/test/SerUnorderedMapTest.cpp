@@ -58,3 +58,20 @@ TEST(SetUnorderedMapTest, deSerializeStringKey)
     EXPECT_EQ(data["OfMiceAndMen"], true);
 }
 
+
+TEST(SetUnorderedMapTest, ReservedFromSizeHint)
+{
+    std::string                             input(R"({"One": 1, "Two": 2, "Three": 3, "Four": 4, "Five": 5, "Six": 6, "Seven": 7, "Eight": 8, "Nine": 9, "Ten": 10, "Eleven": 11, "Twelve": 12, "Thirteen": 13, "Fourteen": 14})");
+    std::unordered_map<std::string, int>    data;
+    std::unordered_map<std::string, int>    expected;
+    expected.reserve(14);
+
+    TS::JsonParser      parser(std::string_view(input.data(), input.size()));
+    TS::DeSerializer    deSerializer(parser);
+    deSerializer.parse(data);
+
+    // The buckets are allocated up front; no rehash is needed while inserting.
+    EXPECT_EQ(14,                       data.size());
+    EXPECT_EQ(expected.bucket_count(),  data.bucket_count());
+    EXPECT_EQ(13,                       data["Thirteen"]);
+}
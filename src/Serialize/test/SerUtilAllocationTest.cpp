@@ -0,0 +1,265 @@
+#include "gtest/gtest.h"
+#include "JsonThor.h"
+#include "SerUtil.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <map>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+using namespace ThorsAnvil::Serialize;
+
+/*
+ * Count the calls to the global operator new while a value is being parsed.
+ * Only the calls made while countAllocations is set are counted.
+ */
+namespace
+{
+    bool            countAllocations    = false;
+    std::size_t     allocationCount     = 0;
+}
+
+// The replacement new/delete pair is malloc/free. When g++ inlines them it sees free()
+// called on memory from a new expression and reports a mismatch that is not there.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+    {
+        ++allocationCount;
+    }
+    void* result = std::malloc(size == 0 ? 1 : size);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+void operator delete(void* data) noexcept
+{
+    std::free(data);
+}
+void operator delete(void* data, std::size_t) noexcept
+{
+    std::free(data);
+}
+#pragma GCC diagnostic pop
+
+namespace
+{
+    template<typename T>
+    std::size_t allocationsToParse(std::string const& input, T& data)
+    {
+        JsonParser      parser(std::string_view(input.data(), input.size()));
+
+        allocationCount     = 0;
+        countAllocations    = true;
+        {
+            DeSerializer    deSerializer(parser);
+            deSerializer.parse(data);
+        }
+        countAllocations    = false;
+        return allocationCount;
+    }
+
+    // Builds an array of count elements using the element generator.
+    template<typename F>
+    std::string makeInput(char open, char close, std::size_t count, F&& element)
+    {
+        std::string     result(1, open);
+        for (std::size_t loop = 0; loop < count; ++loop)
+        {
+            result += (loop == 0 ? "" : ",");
+            result += element(loop);
+        }
+        result += close;
+        return result;
+    }
+
+    // The number of allocations made by each extra element.
+    // Parsing a short and a long input removes the fixed cost of the parse.
+    template<typename T, typename F, typename P>
+    double allocationsPerElement(char open, char close, F&& element, P&& prepare)
+    {
+        std::size_t const   small   = 10;
+        std::size_t const   large   = 110;
+
+        T   shortData;
+        T   longData;
+        prepare(shortData);
+        prepare(longData);
+
+        std::size_t shortCount  = allocationsToParse(makeInput(open, close, small, element), shortData);
+        std::size_t longCount   = allocationsToParse(makeInput(open, close, large, element), longData);
+
+        EXPECT_EQ(small, shortData.size());
+        EXPECT_EQ(large, longData.size());
+        return static_cast<double>(longCount - shortCount) / (large - small);
+    }
+    template<typename T, typename F>
+    double allocationsPerElement(char open, char close, F&& element)
+    {
+        return allocationsPerElement<T>(open, close, element, [](T&){});
+    }
+}
+
+TEST(SerUtilAllocationTest, VectorOfLongString)
+{
+    // Each string is too long for the small string buffer: one allocation for its data.
+    // Capacity is reserved so only the elements are counted.
+    auto element = [](std::size_t loop){return "\"A string that is too long to fit in the small string buffer " + std::to_string(loop) + "\"";};
+    EXPECT_LE((allocationsPerElement<std::vector<std::string>>('[', ']', element, [](auto& data){data.reserve(200);})), 1.0);
+}
+
+TEST(SerUtilAllocationTest, ListOfInt)
+{
+    // One node per element.
+    auto element = [](std::size_t loop){return std::to_string(loop);};
+    EXPECT_LE((allocationsPerElement<std::list<int>>('[', ']', element)), 1.0);
+}
+
+TEST(SerUtilAllocationTest, DequeOfInt)
+{
+    auto element = [](std::size_t loop){return std::to_string(loop);};
+    EXPECT_LE((allocationsPerElement<std::deque<int>>('[', ']', element)), 1.0);
+}
+
+TEST(SerUtilAllocationTest, MapOfStringToInt)
+{
+    // One node per element: the (short) key is moved into the node and the value parsed in place.
+    auto element = [](std::size_t loop){return "\"K" + std::to_string(loop) + "\": " + std::to_string(loop);};
+    EXPECT_LE((allocationsPerElement<std::map<std::string, int>>('{', '}', element)), 1.0);
+}
+
+TEST(SerUtilAllocationTest, MultiMapOfStringToInt)
+{
+    auto element = [](std::size_t loop){return "\"K" + std::to_string(loop) + "\": " + std::to_string(loop);};
+    EXPECT_LE((allocationsPerElement<std::multimap<std::string, int>>('{', '}', element)), 1.0);
+}
+
+TEST(SerUtilAllocationTest, MapRepeatedKeyKeepsFirstValue)
+{
+    std::map<std::string, int>  data;
+    std::string                 input(R"({"One": 1, "Two": 2, "One": 3})");
+
+    allocationsToParse(input, data);
+
+    EXPECT_EQ(2, data.size());
+    EXPECT_EQ(1, data["One"]);
+    EXPECT_EQ(2, data["Two"]);
+}
+
+namespace SerUtilAllocationTest
+{
+    struct Message
+    {
+        std::string                 name;
+        std::vector<int>            values;
+        std::vector<double>         weights;
+    };
+    struct Envelope
+    {
+        long                        id;
+        Message                     body;
+    };
+}
+ThorsAnvil_MakeTrait(SerUtilAllocationTest::Message, name, values, weights);
+ThorsAnvil_MakeTrait(SerUtilAllocationTest::Envelope, id, body);
+
+TEST(SerUtilAllocationTest, ReparseReusesMemory)
+{
+    std::string const   first(R"({"id": 1, "body": {"name": "A name that is too long for the small string buffer", "values": [1, 2, 3, 4, 5, 6], "weights": [1.5, 2.5]}})");
+    std::string const   second(R"({"id": 2, "body": {"name": "Another name that is too long for the small buffer", "values": [6, 5, 4], "weights": [3.5, 4.5]}})");
+
+    SerUtilAllocationTest::Envelope     message;
+    JsonParser                          parser(std::string_view(first.data(), first.size()));
+    {
+        BasicDeSerializer<JsonParser>   deSerializer(parser);
+        deSerializer.parse(message);
+    }
+
+    // A request loop reuses the parser (reset()) and the message (resetObject()).
+    // Refilling the message with one that is no bigger needs no memory.
+    allocationCount     = 0;
+    countAllocations    = true;
+    {
+        resetObject(message);
+        parser.reset(std::string_view(second.data(), second.size()));
+        BasicDeSerializer<JsonParser>   deSerializer(parser);
+        deSerializer.parse(message);
+    }
+    countAllocations    = false;
+
+    EXPECT_EQ(0,                                allocationCount);
+    EXPECT_EQ(2,                                message.id);
+    EXPECT_EQ(std::vector<int>({6, 5, 4}),      message.body.values);
+    EXPECT_EQ(std::vector<double>({3.5, 4.5}),  message.body.weights);
+}
+
+namespace SerUtilAllocationTest
+{
+    struct Item
+    {
+        std::pmr::string                                        name;
+        std::pmr::vector<double>                                weights;
+    };
+    struct Request
+    {
+        long                                                    id;
+        std::pmr::string                                        path;
+        std::pmr::vector<std::pmr::string>                      tags;
+        std::pmr::map<std::pmr::string, std::pmr::vector<int>>  values;
+        std::pmr::vector<Item>                                  items;
+    };
+}
+ThorsAnvil_MakeTrait(SerUtilAllocationTest::Item, name, weights);
+ThorsAnvil_MakeTrait(SerUtilAllocationTest::Request, id, path, tags, values, items);
+
+TEST(SerUtilAllocationTest, MemoryResourceOwnsTheWholeObject)
+{
+    std::string const   input(R"({"id": 1, "path": "/a/path/that/is/longer/than/the/small/string/buffer",)"
+                              R"( "tags": ["A tag that is longer than the small string buffer", "Short"],)"
+                              R"( "values": {"A key that is longer than the small string buffer": [1, 2, 3], "B": [4, 5]},)"
+                              R"( "items": [{"name": "An item name that is longer than the small buffer", "weights": [1.5, 2.5]},)"
+                              R"(           {"name": "Another item name that is longer than the buffer", "weights": [3.5]}]})");
+
+    // Anything not taken from the arena would come from the global operator new
+    // (or throw std::bad_alloc from the null_memory_resource when the buffer is full).
+    std::array<std::byte, 16 * 1024>        buffer;
+    std::pmr::monotonic_buffer_resource     arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    JsonParser                              parser(std::string_view(input.data(), input.size()));
+
+    // The first parse builds the parser state and the member key tables for the types.
+    {
+        SerUtilAllocationTest::Request      request;
+        BasicDeSerializer<JsonParser>       deSerializer(parser, &arena);
+        deSerializer.parse(request);
+    }
+    arena.release();
+
+    parser.reset(std::string_view(input.data(), input.size()));
+    allocationCount     = 0;
+    countAllocations    = true;
+    {
+        SerUtilAllocationTest::Request      request;
+        {
+            BasicDeSerializer<JsonParser>   deSerializer(parser, &arena);
+            deSerializer.parse(request);
+        }
+        EXPECT_EQ(2,                                    request.tags.size());
+        EXPECT_EQ(std::pmr::vector<int>({4, 5}),        request.values["B"]);
+        ASSERT_EQ(2,                                    request.items.size());
+        EXPECT_EQ(std::pmr::vector<double>({3.5}),      request.items[1].weights);
+    }
+    countAllocations    = false;
+    // Freeing the request is a single release of the arena.
+    arena.release();
+
+    EXPECT_EQ(0,                                        allocationCount);
+}
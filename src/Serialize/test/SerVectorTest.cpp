@@ -51,3 +51,27 @@ TEST(SerVectorTest, VectorOfIntDeSerialize)
     EXPECT_EQ(*loop++, 10);
 }
 
+TEST(SerVectorTest, VectorOfIntDeSerializeFromMemory)
+{
+    std::vector<int>    data;
+    std::string_view    input("[1,2,3,101,102]");
+
+    jsonImport(input, data);
+
+    EXPECT_EQ(data, std::vector<int>({1, 2, 3, 101, 102}));
+}
+
+TEST(SerVectorTest, VectorReservedFromSizeHint)
+{
+    std::string         input("[1,2,3,4,5,6,7,8,101,102,9,10]");
+    std::vector<int>    data;
+
+    JsonParser          parser(std::string_view(input.data(), input.size()));
+    DeSerializer        deSerializer(parser);
+    deSerializer.parse(data);
+
+    // The parser counts the values so the vector is allocated once at the right size.
+    EXPECT_EQ(12,   data.size());
+    EXPECT_EQ(12,   data.capacity());
+    EXPECT_EQ(102,  data[9]);
+}
@@ -116,3 +116,210 @@ TEST(SerializeTest, DeSerializeStructureMemberOfValue)
 }
 
 
+
+TEST(SerializeTest, DeSerializeStructureKeysInAnyOrder)
+{
+    SerializeTestExtra      data;
+
+    // Keys are not in declaration (or sorted) order; unknown keys and prefixes of keys are ignored.
+    std::stringstream                   stream(R"({"test": true, "theInt": 12, "normalString": "Done", "theIntegerX": 13, "aNonRealValue": 56.78, "theInteger": 34})");
+    ThorsAnvil::Serialize::JsonParser   parser(stream);
+    ThorsAnvil::Serialize::DeSerializer deSerializer(parser);
+
+    deSerializer.parse(data);
+
+    EXPECT_EQ(data.theInteger,      34);
+    EXPECT_EQ(data.aNonRealValue,   56.78);
+    EXPECT_EQ(data.test,            true);
+    EXPECT_EQ(data.normalString,    "Done");
+}
+
+TEST(SerializeTest, MemberKeysFromTraits)
+{
+    ThorsAnvil::Serialize::MemberKey const* keys = ThorsAnvil::Serialize::Traits<SerializeTestExtra>::getKeys();
+
+    EXPECT_STREQ("theInteger",                  keys[0].name);
+    EXPECT_EQ(10,                               keys[0].size);
+    EXPECT_EQ("\"theInteger\"",                 std::string(keys[0].quoted, keys[0].size + 2));
+    EXPECT_STREQ("normalString",                keys[3].name);
+    EXPECT_EQ("\"normalString\"",               std::string(keys[3].quoted, keys[3].size + 2));
+}
+
+TEST(SerializeTest, SerializeWithConcretePrinter)
+{
+    SerializeTestMembers        data(67, 11, 234567, 123.45, true, "NotASquareAndOnlyOneSide");
+
+    std::stringstream   stream;
+    ThorsAnvil::Serialize::JsonPrinter                                          printer(stream);
+    ThorsAnvil::Serialize::BasicSerializer<ThorsAnvil::Serialize::JsonPrinter>  serializer(printer);
+
+    serializer.print(data);
+    std::string result  = stream.str();
+    result.erase(std::remove_if(std::begin(result), std::end(result), [](char x){return ::isspace(x);}), std::end(result));
+
+    EXPECT_EQ(testData3, result);
+}
+
+TEST(SerializeTest, DeSerializeWithConcreteParser)
+{
+    SerializeTestMembers        data;
+
+    std::stringstream                                                           stream(testData3);
+    ThorsAnvil::Serialize::JsonParser                                           parser(stream);
+    ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser> deSerializer(parser);
+
+    deSerializer.parse(data);
+
+    EXPECT_EQ(data.member1.theInteger,      234567);
+    EXPECT_EQ(data.member1.normalString,    "NotASquareAndOnlyOneSide");
+    EXPECT_EQ(data.member2.aNonRealValue,   123.45);
+    EXPECT_EQ(data.member2.data1,           67);
+    EXPECT_EQ(data.member2.data2,           11);
+}
+
+namespace
+{
+    template<typename DeSerializer>
+    void deSerializeStructOfScalars()
+    {
+        // The scalar members are read with tryGetValue() (token and value in one call).
+        ThorsAnvil::Serialize::JsonParser   parser{std::string_view(testData1)};
+        SerializeTestExtra                  data;
+        for (int loop = 0; loop < 2; ++loop)
+        {
+            parser.reset(testData1);
+            DeSerializer    deSerializer(parser);
+            deSerializer.parse(data);
+
+            EXPECT_EQ(data.theInteger,      34);
+            EXPECT_EQ(data.aNonRealValue,   56.78);
+            EXPECT_EQ(data.test,            true);
+            EXPECT_EQ(data.normalString,    "Done");
+        }
+    }
+    template<typename DeSerializer>
+    void deSerializeScalarFromNonValue()
+    {
+        // tryGetValue() fails when the token is not a value; the DeSerializer reports it.
+        std::string                         input(R"({"theInteger": [1]})");
+        ThorsAnvil::Serialize::JsonParser   parser{std::string_view(input)};
+        SerializeTestExtra                  data;
+
+        EXPECT_THROW(
+            {
+                DeSerializer    deSerializer(parser);
+                deSerializer.parse(data);
+            },
+            std::runtime_error
+        );
+    }
+}
+
+TEST(SerializeTest, DeSerializeStructOfScalars)
+{
+    deSerializeStructOfScalars<ThorsAnvil::Serialize::DeSerializer>();
+    deSerializeStructOfScalars<ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>>();
+}
+
+TEST(SerializeTest, DeSerializeScalarFromNonValue)
+{
+    deSerializeScalarFromNonValue<ThorsAnvil::Serialize::DeSerializer>();
+    deSerializeScalarFromNonValue<ThorsAnvil::Serialize::BasicDeSerializer<ThorsAnvil::Serialize::JsonParser>>();
+}
+
+TEST(SerializeTest, DeSerializeStructureKeysInAndOutOfOrder)
+{
+    // The member after the last match is only a hint.
+    // Objects in declaration order, out of order and with missing members must all decode.
+    std::string const   input[] = {
+        R"({"theInteger": 1, "aNonRealValue": 1.5, "test": true, "normalString": "One"})",
+        R"({"normalString": "Two", "test": false, "theInteger": 2, "aNonRealValue": 2.5})",
+        R"({"aNonRealValue": 3.5, "normalString": "Three"})",
+        R"({"theInteger": 4, "aNonRealValue": 4.5, "test": true, "normalString": "Four"})"
+    };
+    int const           theInteger[]    = {1, 2, 0, 4};
+    double const        aNonRealValue[] = {1.5, 2.5, 3.5, 4.5};
+    bool const          test[]          = {true, false, false, true};
+    char const* const   normalString[]  = {"One", "Two", "Three", "Four"};
+
+    for (int loop = 0; loop < 4; ++loop)
+    {
+        SerializeTestExtra                  data(0, 0, false, "");
+        std::stringstream                   stream(input[loop]);
+        ThorsAnvil::Serialize::JsonParser   parser(stream);
+        ThorsAnvil::Serialize::DeSerializer deSerializer(parser);
+
+        deSerializer.parse(data);
+
+        EXPECT_EQ(data.theInteger,      theInteger[loop]);
+        EXPECT_EQ(data.aNonRealValue,   aNonRealValue[loop]);
+        EXPECT_EQ(data.test,            test[loop]);
+        EXPECT_EQ(data.normalString,    normalString[loop]);
+    }
+}
+
+TEST(SerializeTest, FlattenedMembersOfGrandChild)
+{
+    using Flattened = ThorsAnvil::Serialize::FlattenedMembers<SerializeTestGrandChild>;
+    static_assert(Flattened::available, "ExpandTrait chains are flattened");
+    static_assert(Flattened::size == 7, "All the members of the ancestors are included");
+
+    ThorsAnvil::Serialize::MemberKey const* keys = Flattened::getKeys();
+    EXPECT_STREQ("theInteger",                  keys[0].name);
+    EXPECT_STREQ("data1",                       keys[4].name);
+    EXPECT_STREQ("data3",                       keys[6].name);
+    EXPECT_EQ("\"data3\"",                      std::string(keys[6].quoted, keys[6].size + 2));
+
+    SerializeTestGrandChild     data(5, 67, 11, 234567, 123.45, true, "Leaf");
+    std::stringstream           stream;
+    stream << ThorsAnvil::Serialize::jsonExport(data, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+    std::string const           expected = R"({"theInteger":234567,"aNonRealValue":123.45,"test":true,"normalString":"Leaf","data1":67,"data2":11,"data3":5})";
+    EXPECT_EQ(expected, stream.str());
+
+    // Keys from every level in any order.
+    SerializeTestGrandChild     result;
+    std::stringstream           input(R"({"data3": 6, "normalString": "Back", "data1": 1, "theInteger": 2, "data2": 3, "test": false, "aNonRealValue": 4.5})");
+    input >> ThorsAnvil::Serialize::jsonImport(result);
+
+    EXPECT_EQ(result.data3,         6);
+    EXPECT_EQ(result.data2,         3);
+    EXPECT_EQ(result.data1,         1);
+    EXPECT_EQ(result.theInteger,    2);
+    EXPECT_EQ(result.aNonRealValue, 4.5);
+    EXPECT_EQ(result.test,          false);
+    EXPECT_EQ(result.normalString,  "Back");
+}
+
+TEST(SerializeTest, DocEndCheckedWhenCreatedWhileUnwinding)
+{
+    // A DeSerializer created in a destructor during stack unwinding.
+    // It did not fail itself so it must still check the end of the document.
+    struct ParseWhileUnwinding
+    {
+        bool&   reported;
+        ~ParseWhileUnwinding()
+        {
+            try
+            {
+                std::string                             input("[1]");
+                ThorsAnvil::Serialize::JsonParser       parser{std::string_view(input)};
+                ThorsAnvil::Serialize::DeSerializer     deSerializer(parser);
+                // Nothing is parsed: the array is still open when the DeSerializer is destroyed.
+            }
+            catch (std::runtime_error const&)
+            {
+                reported = true;
+            }
+        }
+    };
+
+    bool    reported = false;
+    try
+    {
+        ParseWhileUnwinding     check{reported};
+        throw 1;
+    }
+    catch (int)
+    {}
+    EXPECT_TRUE(reported);
+}
@@ -51,6 +51,21 @@ class SerializeTestChild: public SerializeTestExtra
         {}
 };
 
+class SerializeTestGrandChild: public SerializeTestChild
+{
+    public:
+    int data3;
+
+    friend class ThorsAnvil::Serialize::Traits<SerializeTestGrandChild>;
+    public:
+        SerializeTestGrandChild()
+        {}
+        SerializeTestGrandChild(int data3, int data1, int data2, int theInteger, double aNonRealValue, bool test, std::string const& normalString)
+            : SerializeTestChild(data1, data2, theInteger, aNonRealValue, test, normalString)
+            , data3(data3)
+        {}
+};
+
 class SerializeTestMembers
 {
     public:
@@ -71,6 +86,7 @@ ThorsAnvil_MakeEnum(RGB, Red, Green, Blue);
 ThorsAnvil_MakeTrait(EumHolder, value);
 ThorsAnvil_MakeTrait(SerializeTestExtra, theInteger, aNonRealValue, test, normalString);
 ThorsAnvil_ExpandTrait(SerializeTestExtra, SerializeTestChild, data1, data2);
+ThorsAnvil_ExpandTrait(SerializeTestChild, SerializeTestGrandChild, data3);
 ThorsAnvil_MakeTrait(SerializeTestMembers, member1, member2);
 
 
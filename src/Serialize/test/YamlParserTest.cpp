@@ -582,5 +582,69 @@ TEST(YamlParserTest, getDataFromBool)
     EXPECT_EQ(false, value4);
 }
 
+TEST(YamlParserTest, getDataWithPlusSign)
+{
+    std::stringstream   stream("[+12, +1.5, +-3]");
+    TA::YamlParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int             value1;
+    ASSERT_NO_THROW(
+        parser.getValue(value1)
+    );
+    EXPECT_EQ(12, value1);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    double          value2;
+    ASSERT_NO_THROW(
+        parser.getValue(value2)
+    );
+    EXPECT_EQ(1.5, value2);
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    int             value3;
+    ASSERT_ANY_THROW(
+        parser.getValue(value3)
+    );
+}
+
+TEST(YamlParserTest, TryGetValue)
+{
+    std::stringstream   stream("[12, [Text]]");
+    TA::YamlParser      parser(stream);
+    int                 value = 0;
+    std::string         text;
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_TRUE(parser.tryGetValue(value));
+    EXPECT_EQ(12,                                       value);
+    // Not a value: the token is pushed back.
+    EXPECT_FALSE(parser.tryGetValue(text));
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayStart, parser.getToken());
+    EXPECT_TRUE(parser.tryGetValue(text));
+    EXPECT_EQ("Text",                                   text);
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::ArrayEnd,   parser.getToken());
+}
+TEST(YamlParserTest, ViewOfNonScalar)
+{
+    std::stringstream   stream("{Key: Value, Map: {A: 1}}");
+    TA::YamlParser      parser(stream);
+
+    EXPECT_EQ(ParserInterface::ParserToken::DocStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ("Key",                                    parser.getKeyView());
+    EXPECT_EQ(ParserInterface::ParserToken::Value,      parser.getToken());
+    EXPECT_EQ("Value",                                  parser.getValueView());
+    EXPECT_EQ(ParserInterface::ParserToken::Key,        parser.getToken());
+    EXPECT_EQ(ParserInterface::ParserToken::MapStart,   parser.getToken());
+    // The current event is a mapping not a scalar.
+    EXPECT_THROW(parser.getValueView(),                 std::runtime_error);
+    EXPECT_THROW(parser.getKeyView(),                   std::runtime_error);
+}
+
 #endif
 
@@ -224,4 +224,22 @@ TEST(YamlPrinterTest, PuttingKeyInArray)
         printer.addKey("This old house");
     );
 }
+TEST(YamlPrinterTest, NumbersRoundTrip)
+{
+    std::stringstream                   stream;
+    ThorsAnvil::Serialize::YamlPrinter  printer(stream, ThorsAnvil::Serialize::PrinterInterface::OutputType::Stream);
+
+    printer.openDoc();
+    printer.openArray(-1);
+    printer.addValue(0.1 + 0.2);
+    printer.addValue(123456789.0);
+    printer.addValue(-42);
+    printer.closeArray();
+    printer.closeDoc();
+
+    std::string     result  = stream.str();
+    result.erase(std::remove_if(std::begin(result), std::end(result), [](char x){return ::isspace(x);}), std::end(result));
+    EXPECT_EQ("---[0.30000000000000004,123456789,-42]...", result);
+}
+
 #endif